@@ -0,0 +1,423 @@
+// Headless micro-benchmarks for the chunk pipeline.
+//
+//   wet_bench [--out FILE] [--samples N] [--warmup N] [--filter TEXT] [--label TEXT]
+//
+// Every case uses fixed seeds and fixed inputs, so two runs on the same machine do
+// the same work and their JSON (default wet_bench.json) can be diffed across commits.
+// Each case runs its warm-up iterations first (reported separately: the first one
+// includes cold caches and allocations), then the timed samples.
+// No window is opened. The meshing and world cases need a GL context for the tile
+// atlas and light shader; when none can be created they are skipped with a message
+// and the CPU-only cases still run.
+#include <SFML/Graphics.hpp>
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <exception>
+#include <fstream>
+#include <functional>
+#include <memory>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "engine/tile/Chunk.hpp"
+#include "engine/tile/LightShader.hpp"
+#include "engine/tile/TileAtlas.hpp"
+#include "engine/tile/TileBatch.hpp"
+#include "engine/world/World.hpp"
+#include "engine/world/WorldSnapshot.hpp"
+
+namespace {
+
+constexpr unsigned WORLD_SEED = 1337;
+constexpr unsigned PLACEMENT_SEED = 42; // torch and edit positions
+
+struct Options {
+    std::string out = "wet_bench.json";
+    std::string filter;
+    std::string label;
+    int samples = 0; // 0: each case's own default
+    int warmup = -1; // -1: each case's own default
+};
+
+struct Result {
+    std::string name;
+    std::string params;           // what the case was run with, human-readable
+    std::vector<double> warmupUs; // in run order
+    std::vector<double> samplesUs; // sorted once finished
+};
+
+double percentile(const std::vector<double>& sorted, double p) {
+    if (sorted.empty()) return 0.0;
+    // Nearest rank: the smallest sample with at least p of the samples at or below it
+    size_t rank = static_cast<size_t>(p * static_cast<double>(sorted.size()) + 0.999999);
+    rank = std::clamp<size_t>(rank, 1, sorted.size());
+    return sorted[rank - 1];
+}
+
+double mean(const std::vector<double>& v) {
+    double sum = 0.0;
+    for (double x : v) sum += x;
+    return v.empty() ? 0.0 : sum / static_cast<double>(v.size());
+}
+
+class Bench {
+public:
+    explicit Bench(const Options& opt) : opt_(opt) {}
+
+    bool wants(const std::string& name) const {
+        return opt_.filter.empty() || name.find(opt_.filter) != std::string::npos;
+    }
+
+    // Times body(i) for warm-up + sample iterations; i counts from 0 across both, so
+    // the body can walk a fixed input sequence. setup(i) runs before each iteration
+    // and is not timed.
+    void run(const std::string& name, const std::string& params, int samples, int warmup,
+             const std::function<void(int)>& body,
+             const std::function<void(int)>& setup = nullptr) {
+        if (!wants(name)) return;
+        if (opt_.samples > 0) samples = opt_.samples;
+        if (opt_.warmup >= 0) warmup = opt_.warmup;
+
+        Result r{name, params, {}, {}};
+        r.warmupUs.reserve(static_cast<size_t>(warmup));
+        r.samplesUs.reserve(static_cast<size_t>(samples));
+        for (int i = 0; i < warmup + samples; ++i) {
+            if (setup) setup(i);
+            const auto t0 = std::chrono::steady_clock::now();
+            body(i);
+            const auto t1 = std::chrono::steady_clock::now();
+            const double us = std::chrono::duration<double, std::micro>(t1 - t0).count();
+            (i < warmup ? r.warmupUs : r.samplesUs).push_back(us);
+        }
+        std::sort(r.samplesUs.begin(), r.samplesUs.end());
+
+        std::printf("%-34s %-26s warm-up %10.1f  median %10.1f  p99 %10.1f us\n",
+                    r.name.c_str(), r.params.c_str(), r.warmupUs.empty() ? 0.0 : r.warmupUs.front(),
+                    percentile(r.samplesUs, 0.5), percentile(r.samplesUs, 0.99));
+        results_.push_back(std::move(r));
+    }
+
+    void writeJson(const std::string& path) const {
+        std::ofstream f(path);
+        if (!f) throw std::runtime_error("cannot write " + path);
+
+        auto str = [](const std::string& s) {
+            std::string q = "\"";
+            for (char c : s) {
+                if (c == '"' || c == '\\') q += '\\';
+                if (static_cast<unsigned char>(c) >= 0x20) q += c;
+            }
+            return q + "\"";
+        };
+        auto num = [](double v) {
+            char buf[32];
+            std::snprintf(buf, sizeof(buf), "%.3f", v);
+            return std::string(buf);
+        };
+
+        f << "{\n";
+        f << "  \"label\": " << str(opt_.label) << ",\n";
+#ifdef NDEBUG
+        f << "  \"build\": \"release\",\n";
+#else
+        f << "  \"build\": \"debug\",\n";
+#endif
+        f << "  \"hardware_threads\": " << std::thread::hardware_concurrency() << ",\n";
+        f << "  \"world_seed\": " << WORLD_SEED << ",\n";
+        f << "  \"chunk\": [" << CHUNK_W << ", " << CHUNK_H << "],\n";
+        f << "  \"unit\": \"us\",\n";
+        f << "  \"cases\": [\n";
+        for (size_t i = 0; i < results_.size(); ++i) {
+            const Result& r = results_[i];
+            f << "    {\"name\": " << str(r.name) << ", \"params\": " << str(r.params)
+              << ", \"warmup\": " << r.warmupUs.size()
+              << ", \"warmup_first\": " << num(r.warmupUs.empty() ? 0.0 : r.warmupUs.front())
+              << ", \"warmup_mean\": " << num(mean(r.warmupUs))
+              << ", \"samples\": " << r.samplesUs.size()
+              << ", \"min\": " << num(r.samplesUs.empty() ? 0.0 : r.samplesUs.front())
+              << ", \"median\": " << num(percentile(r.samplesUs, 0.5))
+              << ", \"mean\": " << num(mean(r.samplesUs))
+              << ", \"p99\": " << num(percentile(r.samplesUs, 0.99))
+              << ", \"max\": " << num(r.samplesUs.empty() ? 0.0 : r.samplesUs.back()) << "}"
+              << (i + 1 < results_.size() ? ",\n" : "\n");
+        }
+        f << "  ]\n}\n";
+    }
+
+private:
+    Options opt_;
+    std::vector<Result> results_;
+};
+
+// Chunk coordinates the single-chunk cases cycle through: surface, sky, shallow
+// caves and deep rock, left and right of the origin
+const std::vector<ChunkCoord>& sampleCoords() {
+    static const std::vector<ChunkCoord> coords = {
+        {0, 0}, {0, -1}, {1, 0}, {-3, 0}, {0, 1}, {2, 1}, {-1, 2}, {0, 4}, {5, 3}, {-7, 6},
+    };
+    return coords;
+}
+
+// Turns count distinct tiles into torches, at positions from a fixed seed
+void placeTorches(Chunk& chunk, unsigned count) {
+    std::mt19937 rng(PLACEMENT_SEED);
+    for (unsigned placed = 0; placed < count;) {
+        const unsigned x = rng() % CHUNK_W;
+        const unsigned y = rng() % CHUNK_H;
+        if (chunk.get(x, y) == Tile::Torch) continue;
+        chunk.set(x, y, Tile::Torch);
+        ++placed;
+    }
+}
+
+void benchGenerate(Bench& bench) {
+    const auto& coords = sampleCoords();
+    auto chunk = std::make_unique<Chunk>(coords[0]);
+    bench.run("chunk_generate", "10 coords", 200, 20,
+              [&](int) { chunk->generate(WORLD_SEED); },
+              [&](int i) { chunk->reset(coords[static_cast<size_t>(i) % coords.size()]); });
+}
+
+void benchLighting(Bench& bench) {
+    // A cave chunk under the surface, so the sky seeds are dark and torches matter
+    const ChunkCoord cc{0, 2};
+    for (unsigned torches : {0u, 10u, 200u}) {
+        Chunk chunk(cc);
+        chunk.generate(WORLD_SEED);
+        placeTorches(chunk, torches);
+        for (unsigned x = 0; x < CHUNK_W; ++x) chunk.getLightMap().setSkyAbove(x, 0);
+
+        char params[32];
+        std::snprintf(params, sizeof(params), "torches %u", torches);
+        bench.run("lightmap_calculate", params, 200, 10,
+                  [&](int) { chunk.getLightMap().calculateLighting(chunk); });
+    }
+
+    // Surface chunk: sky light dominates
+    Chunk surface({0, 0});
+    surface.generate(WORLD_SEED);
+    bench.run("lightmap_calculate", "surface, no torches", 200, 10,
+              [&](int) { surface.getLightMap().calculateLighting(surface); });
+}
+
+void benchMeshing(Bench& bench, const TileAtlas& atlas, const LightShader& light) {
+    const auto& coords = sampleCoords();
+    std::vector<std::unique_ptr<Chunk>> chunks;
+    for (ChunkCoord cc : coords) {
+        chunks.push_back(std::make_unique<Chunk>(cc));
+        chunks.back()->generate(WORLD_SEED);
+        chunks.back()->updateLighting();
+    }
+    TileBatch batch;
+    bench.run("tilebatch_build", light.active() ? "10 coords, shader" : "10 coords, baked", 200, 20,
+              [&](int i) { batch.build(*chunks[static_cast<size_t>(i) % chunks.size()], atlas, light, 255); });
+}
+
+// One sample per frame of a scripted camera path; workers are off so chunk
+// generation happens inside ensureVisible, within the default frame budget
+void benchSweep(Bench& bench, const TileAtlas& atlas) {
+    constexpr int FRAMES = 240;
+    constexpr float STEP = 24.f; // px per frame: about 1440 px/s at 60 fps
+
+    auto world = std::make_unique<World>(&atlas, WORLD_SEED, World::DEFAULT_MEMORY_BUDGET, 0u);
+    world->setScreenSize({1280u, 720u});
+    sf::View view(sf::FloatRect({0.f, 0.f}, {1280.f, 720.f}));
+
+    // Right along the surface, down into the caves, then back left
+    auto cameraAt = [&](int frame) {
+        const int leg = FRAMES / 3;
+        const int phase = frame % FRAMES;
+        sf::Vector2f c{640.f, 360.f};
+        if (phase < leg) {
+            c.x += STEP * static_cast<float>(phase);
+        } else if (phase < 2 * leg) {
+            c.x += STEP * static_cast<float>(leg);
+            c.y += STEP * static_cast<float>(phase - leg);
+        } else {
+            c.x += STEP * static_cast<float>(3 * leg - phase);
+            c.y += STEP * static_cast<float>(leg);
+        }
+        return c;
+    };
+
+    bench.run("world_ensure_visible", "sweep 240 frames, inline", FRAMES, 1,
+              [&](int) { world->ensureVisible(view); },
+              [&](int i) { view.setCenter(cameraAt(i)); });
+}
+
+// A screen of chunks going through a change in the time of day. With the light
+// shader that is a uniform and nothing is rebuilt; with baked lighting every chunk
+// in view is remeshed, across all cores. The whole view is rebuilt each sample.
+void benchPrepare(Bench& bench, const TileAtlas& atlas) {
+    auto world = std::make_unique<World>(&atlas, WORLD_SEED);
+    world->setScreenSize({1280u, 720u});
+    world->setFrameBudget(std::chrono::microseconds(0));
+    const sf::View view(sf::FloatRect({0.f, 0.f}, {2560.f, 1440.f}));
+    while (world->loadedChunkCount() == 0 || world->pendingChunkCount() > 0) {
+        world->ensureVisible(view);
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    world->ensureVisible(view);
+
+    const std::string params = std::string(world->shaderLighting() ? "shader" : "baked") + ", " +
+                               std::to_string(WorkerPool::defaultThreadCount()) + " workers";
+    bench.run("world_prepare_frame", params, 50, 3,
+              [&](int) { world->prepareFrame(view); },
+              [&](int i) { world->updateAmbientLight(i % 2 ? 4u : 12u); });
+}
+
+// Snapshot of a 2560x1440 view for the render thread after one tile edit: one
+// chunk's meshes are copied, the rest shared with the previous snapshot
+void benchPublish(Bench& bench, const TileAtlas& atlas) {
+    auto world = std::make_unique<World>(&atlas, WORLD_SEED);
+    world->setScreenSize({1280u, 720u});
+    world->setFrameBudget(std::chrono::microseconds(0));
+    const sf::View view(sf::FloatRect({0.f, 0.f}, {2560.f, 1440.f}));
+    while (world->loadedChunkCount() == 0 || world->pendingChunkCount() > 0) {
+        world->ensureVisible(view);
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    world->ensureVisible(view);
+    world->prepareFrame(view);
+
+    WorldSnapshot snapshot;
+    world->publish(view, snapshot);
+    bench.run("world_publish", "1 chunk edited", 100, 10,
+              [&](int) { world->publish(view, snapshot); },
+              [&](int i) {
+                  world->setTileAtTile(20, 20, i % 2 ? Tile::Stone : Tile::Air);
+                  world->prepareFrame(view);
+              });
+}
+
+// Bursts of single-tile edits around the camera, alternating digging and placing
+// (torches every so often), each relit incrementally
+void benchEdits(Bench& bench, const TileAtlas& atlas) {
+    constexpr int BURST = 64;
+
+    auto world = std::make_unique<World>(&atlas, WORLD_SEED, World::DEFAULT_MEMORY_BUDGET, 0u);
+    world->setScreenSize({1280u, 720u});
+    world->setFrameBudget(std::chrono::microseconds(0)); // load the whole view up front
+    const sf::View view(sf::FloatRect({0.f, 0.f}, {1280.f, 720.f}));
+    world->ensureVisible(view);
+
+    constexpr unsigned tilesX = 1280 / TILE_SIZE;
+    constexpr unsigned tilesY = 720 / TILE_SIZE;
+    std::mt19937 rng(PLACEMENT_SEED);
+    std::vector<TileEdit> edits;
+
+    bench.run("world_set_tile_burst", "64 edits", 100, 10,
+              [&](int) {
+                  for (const TileEdit& e : edits) world->setTileAtTile(e.tx, e.ty, e.id);
+              },
+              [&](int i) {
+                  edits.clear();
+                  for (int k = 0; k < BURST; ++k) {
+                      TileID id = (i % 2 == 0) ? Tile::Air : Tile::Stone;
+                      if (k % 16 == 0) id = Tile::Torch;
+                      edits.push_back({static_cast<int>(rng() % tilesX), static_cast<int>(rng() % tilesY), id});
+                  }
+              });
+}
+
+// The tile atlas and light shader, created the first time a case asks for them so
+// the CPU-only cases never touch GL
+class GlResources {
+public:
+    // False when no GL context can be created; error() then says why
+    bool available() {
+        init();
+        return atlas_ != nullptr;
+    }
+    const std::string& error() const { return error_; }
+
+    const TileAtlas& atlas() const { return *atlas_; }
+    const LightShader& light() const { return *light_; }
+
+private:
+    void init() {
+        if (tried_) return;
+        tried_ = true;
+#if defined(__unix__) && !defined(__APPLE__)
+        // SFML aborts rather than fails when it cannot reach an X server
+        if (!std::getenv("DISPLAY")) {
+            error_ = "no display to create a GL context on (DISPLAY is not set)";
+            return;
+        }
+#endif
+        try {
+            context_ = std::make_unique<sf::Context>();
+            if (!context_->setActive(true)) throw std::runtime_error("cannot activate a GL context");
+            atlas_ = std::make_unique<const TileAtlas>(TILE_SIZE);
+            light_ = std::make_unique<const LightShader>();
+        } catch (const std::exception& e) {
+            error_ = e.what();
+            atlas_.reset();
+            context_.reset();
+        }
+    }
+
+    bool tried_ = false;
+    std::string error_;
+    std::unique_ptr<sf::Context> context_;
+    std::unique_ptr<const TileAtlas> atlas_;
+    std::unique_ptr<const LightShader> light_;
+};
+
+bool parseArgs(int argc, char** argv, Options& opt) {
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        auto value = [&]() -> const char* { return i + 1 < argc ? argv[++i] : nullptr; };
+        const char* v = nullptr;
+        if      (arg == "--out"     && (v = value())) opt.out = v;
+        else if (arg == "--filter"  && (v = value())) opt.filter = v;
+        else if (arg == "--label"   && (v = value())) opt.label = v;
+        else if (arg == "--samples" && (v = value())) opt.samples = std::atoi(v);
+        else if (arg == "--warmup"  && (v = value())) opt.warmup = std::atoi(v);
+        else {
+            std::fprintf(stderr,
+                         "usage: %s [--out FILE] [--samples N] [--warmup N] [--filter TEXT] [--label TEXT]\n",
+                         argv[0]);
+            return false;
+        }
+    }
+    return true;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    Options opt;
+    if (!parseArgs(argc, argv, opt)) return 2;
+
+    try {
+        Bench bench(opt);
+        GlResources gl;
+        // Runs a case that needs GL, or says why it was skipped
+        auto withGl = [&](const char* name, const std::function<void()>& body) {
+            if (!bench.wants(name)) return;
+            if (gl.available()) body();
+            else std::printf("%-34s skipped: %s\n", name, gl.error().c_str());
+        };
+
+        benchGenerate(bench);
+        benchLighting(bench);
+        withGl("tilebatch_build", [&] { benchMeshing(bench, gl.atlas(), gl.light()); });
+        withGl("world_ensure_visible", [&] { benchSweep(bench, gl.atlas()); });
+        withGl("world_prepare_frame", [&] { benchPrepare(bench, gl.atlas()); });
+        withGl("world_publish", [&] { benchPublish(bench, gl.atlas()); });
+        withGl("world_set_tile_burst", [&] { benchEdits(bench, gl.atlas()); });
+
+        bench.writeJson(opt.out);
+        std::printf("wrote %s\n", opt.out.c_str());
+    } catch (const std::exception& e) {
+        std::fprintf(stderr, "wet_bench: %s\n", e.what());
+        return 1;
+    }
+    return 0;
+}
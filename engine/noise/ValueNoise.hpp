@@ -1,6 +1,11 @@
 #pragma once
+#include <cstddef>
 #include <cstdint>
 #include <cmath>
+#include <vector>
+#if defined(__AVX2__) || defined(__SSE2__) || defined(_M_X64)
+#include <immintrin.h>
+#endif
 
 // 64-bit mix (SplitMix64)
 static inline std::uint64_t smix(std::uint64_t x) {
@@ -29,8 +34,28 @@ static inline float rand2i(std::int64_t xi, std::int64_t yi, std::uint64_t seed)
     return hash01(pack2i(xi, yi, seed));
 }
 
+// a * b + c, fused exactly where the target has FMA and never otherwise. Spelled
+// out so the compiler has no multiply-adds left to contract on its own: the scalar
+// and batched paths then round identically whatever -ffp-contract / -march say.
+static inline float noiseMadd(float a, float b, float c) {
+#if defined(FP_FAST_FMAF) || defined(__FP_FAST_FMAF)
+    return std::fma(a, b, c);
+#else
+    const float p = a * b;
+    return p + c;
+#endif
+}
+
 static inline float smooth(float t) { // quintic
-    return t * t * t * (t * (t * 6.f - 15.f) + 10.f);
+    return t * t * t * noiseMadd(t, noiseMadd(t, 6.f, -15.f), 10.f);
+}
+
+// Bilinear blend of the four lattice values around a sample (sx, sy already smoothed).
+// Shared by the scalar and batched paths so both round identically.
+static inline float blendCorners(float r00, float r10, float r01, float r11, float sx, float sy) {
+    const float a  = noiseMadd(r10 - r00, sx, r00);
+    const float b  = noiseMadd(r11 - r01, sx, r01);
+    return noiseMadd(b - a, sy, a);
 }
 
 // 2D value noise with smooth bilinear interpolation
@@ -44,10 +69,7 @@ static inline float valueNoise2(float x, float y, std::uint64_t seed) {
     const float r01 = rand2i(xi+0, yi+1, seed);
     const float r11 = rand2i(xi+1, yi+1, seed);
 
-    const float sx = smooth(tx), sy = smooth(ty);
-    const float a  = r00 + (r10 - r00) * sx;
-    const float b  = r01 + (r11 - r01) * sx;
-    return a + (b - a) * sy;
+    return blendCorners(r00, r10, r01, r11, smooth(tx), smooth(ty));
 }
 
 // Simple FBM
@@ -56,8 +78,145 @@ static inline float fbm2(float x, float y, std::uint64_t seed,
 {
     float f = 0.0f, amp = 0.5f, fx = x, fy = y;
     for (int i = 0; i < octaves; ++i) {
-        f  += valueNoise2(fx, fy, seed + (std::uint64_t)i * 1315423911u) * amp;
+        f   = noiseMadd(valueNoise2(fx, fy, seed + (std::uint64_t)i * 1315423911u), amp, f);
         fx *= lacunarity; fy *= lacunarity; amp *= gain;
     }
     return f; // ~[0,1)
 }
+
+// ---------------------------------------------------------------------------
+// Batched evaluation
+//
+// fbm2Grid fills a whole block of samples at once and returns exactly what fbm2
+// returns for each of them, bit for bit: the per-sample arithmetic is the same
+// expressions in the same order (multiply-adds go through noiseMadd, so contraction
+// can't round the two differently), and only the lattice hashing is shared and
+// vectorised (hashes are integer work, so they are exact in any lane width).
+// ---------------------------------------------------------------------------
+
+// rand2i(xs[k], y, seed) for a row of lattice x coordinates; rowKey = pack2i(0, y, seed).
+// AVX2 hashes 4 lattice points per step, SSE2 2, otherwise scalar.
+static inline void rand2iRow(const std::int64_t* xs, std::size_t n, std::uint64_t rowKey, float* out) {
+    std::size_t k = 0;
+#if defined(__AVX2__)
+    // 64x64 -> 64 bit multiply by a constant from three 32x32 -> 64 multiplies
+    auto mul64 = [](__m256i a, std::uint64_t c) {
+        const __m256i cLo = _mm256_set1_epi64x(static_cast<long long>(c & 0xFFFFFFFFull));
+        const __m256i cHi = _mm256_set1_epi64x(static_cast<long long>(c >> 32));
+        const __m256i lo = _mm256_mul_epu32(a, cLo);
+        const __m256i cross = _mm256_add_epi64(_mm256_mul_epu32(_mm256_srli_epi64(a, 32), cLo),
+                                               _mm256_mul_epu32(a, cHi));
+        return _mm256_add_epi64(lo, _mm256_slli_epi64(cross, 32));
+    };
+    const __m256i key = _mm256_set1_epi64x(static_cast<long long>(rowKey));
+    const __m256i golden = _mm256_set1_epi64x(static_cast<long long>(0x9E3779B97F4A7C15ull));
+    const __m256i lowDwords = _mm256_setr_epi32(0, 2, 4, 6, 1, 3, 5, 7);
+    const __m128 scale = _mm_set1_ps(1.0f / 16777216.0f); // exact: power of two
+    for (; k + 4 <= n; k += 4) {
+        __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(xs + k));
+        x = _mm256_xor_si256(mul64(x, 0x9E3779B185EBCA87ull), key); // pack2i
+        x = _mm256_add_epi64(x, golden);                              // smix
+        x = mul64(_mm256_xor_si256(x, _mm256_srli_epi64(x, 30)), 0xBF58476D1CE4E5B9ull);
+        x = mul64(_mm256_xor_si256(x, _mm256_srli_epi64(x, 27)), 0x94D049BB133111EBull);
+        x = _mm256_xor_si256(x, _mm256_srli_epi64(x, 31));
+        // top 24 bits -> [0,1); they fit an int32, so narrow the lanes and convert
+        const __m256i bits = _mm256_permutevar8x32_epi32(_mm256_srli_epi64(x, 40), lowDwords);
+        _mm_storeu_ps(out + k, _mm_mul_ps(_mm_cvtepi32_ps(_mm256_castsi256_si128(bits)), scale));
+    }
+#elif defined(__SSE2__) || defined(_M_X64)
+    auto mul64 = [](__m128i a, std::uint64_t c) {
+        const __m128i cLo = _mm_set1_epi64x(static_cast<long long>(c & 0xFFFFFFFFull));
+        const __m128i cHi = _mm_set1_epi64x(static_cast<long long>(c >> 32));
+        const __m128i lo = _mm_mul_epu32(a, cLo);
+        const __m128i cross = _mm_add_epi64(_mm_mul_epu32(_mm_srli_epi64(a, 32), cLo), _mm_mul_epu32(a, cHi));
+        return _mm_add_epi64(lo, _mm_slli_epi64(cross, 32));
+    };
+    const __m128i key = _mm_set1_epi64x(static_cast<long long>(rowKey));
+    const __m128i golden = _mm_set1_epi64x(static_cast<long long>(0x9E3779B97F4A7C15ull));
+    for (; k + 2 <= n; k += 2) {
+        __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(xs + k));
+        x = _mm_xor_si128(mul64(x, 0x9E3779B185EBCA87ull), key);
+        x = _mm_add_epi64(x, golden);
+        x = mul64(_mm_xor_si128(x, _mm_srli_epi64(x, 30)), 0xBF58476D1CE4E5B9ull);
+        x = mul64(_mm_xor_si128(x, _mm_srli_epi64(x, 27)), 0x94D049BB133111EBull);
+        x = _mm_xor_si128(x, _mm_srli_epi64(x, 31));
+        alignas(16) std::uint64_t h[2];
+        _mm_store_si128(reinterpret_cast<__m128i*>(h), _mm_srli_epi64(x, 40));
+        out[k]     = (float)h[0] / 16777216.0f;
+        out[k + 1] = (float)h[1] / 16777216.0f;
+    }
+#endif
+    for (; k < n; ++k) {
+        out[k] = hash01((std::uint64_t)(xs[k]) * 0x9E3779B185EBCA87ull ^ rowKey);
+    }
+}
+
+// Lattice cells touched by a non-decreasing run of sample coordinates along one axis:
+// cell[k] is the index in lattice of floor(c[k]) (floor(c[k]) + 1 sits right after it)
+// and s[k] the smoothed fraction
+struct NoiseAxis {
+    std::vector<std::int64_t> lattice;
+    std::vector<std::uint32_t> cell;
+    std::vector<float> s;
+
+    void build(const float* c, std::size_t n) {
+        lattice.clear();
+        cell.resize(n);
+        s.resize(n);
+        for (std::size_t k = 0; k < n; ++k) {
+            const float f = std::floor(c[k]);
+            const int   i = (int)f;
+            // Same rounding as valueNoise2: int cell, then widened
+            const std::int64_t i0 = i + 0, i1 = i + 1;
+            // Sorted input: the last lattice entry is below i0, i0 itself, or i1
+            if (lattice.empty() || lattice.back() < i0) lattice.push_back(i0);
+            if (lattice.back() < i1) lattice.push_back(i1);
+            cell[k] = static_cast<std::uint32_t>(lattice.size() - 2);
+            s[k] = smooth(c[k] - f);
+        }
+    }
+};
+
+// out[j * nx + i] = fbm2(xs[i], ys[j], seed, octaves, lacunarity, gain), bit for bit.
+// xs and ys must be non-decreasing (e.g. one chunk's tile columns and rows). Lattice
+// values are hashed once per octave for the cells the samples actually touch instead
+// of four times per sample, so a 128x64 block needs a few thousand hashes, not ~130k.
+static inline void fbm2Grid(const float* xs, std::size_t nx, const float* ys, std::size_t ny,
+                            std::uint64_t seed, float* out,
+                            int octaves = 4, float lacunarity = 2.f, float gain = 0.5f)
+{
+    thread_local std::vector<float> fx, fy, values;
+    thread_local NoiseAxis ax, ay;
+    fx.assign(xs, xs + nx);
+    fy.assign(ys, ys + ny);
+    for (std::size_t k = 0; k < nx * ny; ++k) out[k] = 0.0f;
+
+    float amp = 0.5f;
+    for (int o = 0; o < octaves; ++o) {
+        const std::uint64_t octaveSeed = seed + (std::uint64_t)o * 1315423911u;
+        ax.build(fx.data(), nx);
+        ay.build(fy.data(), ny);
+
+        // Hash the touched lattice: one row of x cells per y cell
+        const std::size_t lw = ax.lattice.size();
+        values.resize(lw * ay.lattice.size());
+        for (std::size_t r = 0; r < ay.lattice.size(); ++r) {
+            rand2iRow(ax.lattice.data(), lw, pack2i(0, ay.lattice[r], octaveSeed), values.data() + r * lw);
+        }
+
+        for (std::size_t j = 0; j < ny; ++j) {
+            const float* row0 = values.data() + std::size_t(ay.cell[j]) * lw;
+            const float* row1 = row0 + lw;
+            const float sy = ay.s[j];
+            float* dst = out + j * nx;
+            for (std::size_t i = 0; i < nx; ++i) {
+                const std::uint32_t c = ax.cell[i];
+                dst[i] = noiseMadd(blendCorners(row0[c], row0[c + 1], row1[c], row1[c + 1], ax.s[i], sy), amp, dst[i]);
+            }
+        }
+
+        for (float& v : fx) v *= lacunarity;
+        for (float& v : fy) v *= lacunarity;
+        amp *= gain;
+    }
+}
@@ -0,0 +1,295 @@
+#include "engine/profile/Profiler.hpp"
+
+#if WET_PROFILE
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <string>
+
+namespace {
+
+struct Event {
+    const char* name;
+    std::uint64_t startNs, endNs;
+};
+
+// One thread's latest events. The owning thread is the only writer: it fills the
+// slot for event `head`, then publishes it by advancing head. Readers copy a range
+// and then drop whatever the writer may have lapped meanwhile. Slot fields are
+// relaxed atomics so those racing reads are still well defined.
+struct Ring {
+    static constexpr std::uint64_t MASK = Profiler::RING_EVENTS - 1;
+    static_assert((Profiler::RING_EVENTS & MASK) == 0, "ring size must be a power of two");
+
+    struct Slot {
+        std::atomic<const char*> name{nullptr};
+        std::atomic<std::uint64_t> startNs{0}, endNs{0};
+    };
+
+    std::unique_ptr<Slot[]> slots{new Slot[Profiler::RING_EVENTS]};
+    std::atomic<std::uint64_t> head{0}; // events written so far
+    std::atomic<bool> owned{true};      // cleared when the thread exits; the ring is then reused
+    unsigned tid = 0;                   // these two are guarded by the registry mutex
+    std::string threadName;
+    std::uint64_t statsCursor = 0;      // main thread: events already folded into the stats
+
+    void push(const char* name, std::uint64_t startNs, std::uint64_t endNs) {
+        const std::uint64_t i = head.load(std::memory_order_relaxed);
+        // Orders the slot writes after the previous publish, so a reader that sees
+        // them also sees head >= i (see read)
+        std::atomic_thread_fence(std::memory_order_release);
+        Slot& s = slots[i & MASK];
+        s.name.store(name, std::memory_order_relaxed);
+        s.startNs.store(startNs, std::memory_order_relaxed);
+        s.endNs.store(endNs, std::memory_order_relaxed);
+        head.store(i + 1, std::memory_order_release);
+    }
+
+    // Appends the intact events among [from, head) to out; returns the head it read up to
+    std::uint64_t read(std::uint64_t from, std::vector<Event>& out) const {
+        const std::uint64_t h = head.load(std::memory_order_acquire);
+        const std::uint64_t begin = std::max(from, h > Profiler::RING_EVENTS ? h - Profiler::RING_EVENTS : 0);
+        const size_t first = out.size();
+        for (std::uint64_t i = begin; i < h; ++i) {
+            const Slot& s = slots[i & MASK];
+            out.push_back({s.name.load(std::memory_order_relaxed), s.startNs.load(std::memory_order_relaxed),
+                           s.endNs.load(std::memory_order_relaxed)});
+        }
+        // The writer is at most filling event h2 now, which reuses the slot of event
+        // h2 - RING_EVENTS; anything up to that may have been overwritten while copying
+        std::atomic_thread_fence(std::memory_order_acquire);
+        const std::uint64_t h2 = head.load(std::memory_order_relaxed);
+        const std::uint64_t intact = h2 + 1 > Profiler::RING_EVENTS ? h2 + 1 - Profiler::RING_EVENTS : 0;
+        if (intact > begin) {
+            const size_t torn = static_cast<size_t>(std::min(intact, h) - begin);
+            out.erase(out.begin() + static_cast<std::ptrdiff_t>(first),
+                      out.begin() + static_cast<std::ptrdiff_t>(first + torn));
+        }
+        return h;
+    }
+};
+
+// Rings are never freed, so a pointer handed out stays valid; a ring whose thread
+// exited goes to the next new thread (its older events then show under that thread)
+struct Registry {
+    std::mutex mutex;
+    std::vector<std::unique_ptr<Ring>> rings;
+    unsigned nextTid = 1;
+};
+
+Registry& registry() {
+    static Registry* r = new Registry; // outlives every thread_local below
+    return *r;
+}
+
+struct ThreadRing {
+    Ring* ring = nullptr;
+    ~ThreadRing() {
+        if (ring) ring->owned.store(false, std::memory_order_release);
+    }
+};
+thread_local ThreadRing threadRing;
+
+Ring& localRing() {
+    if (threadRing.ring) return *threadRing.ring;
+
+    Registry& reg = registry();
+    std::lock_guard<std::mutex> lock(reg.mutex);
+    Ring* ring = nullptr;
+    for (const auto& r : reg.rings) {
+        if (!r->owned.load(std::memory_order_acquire)) {
+            ring = r.get();
+            ring->owned.store(true, std::memory_order_relaxed);
+            ring->threadName.clear();
+            break;
+        }
+    }
+    if (!ring) {
+        reg.rings.push_back(std::make_unique<Ring>());
+        ring = reg.rings.back().get();
+    }
+    ring->tid = reg.nextTid++;
+    threadRing.ring = ring;
+    return *ring;
+}
+
+// Main-thread state behind endFrame()
+struct SectionAccum {
+    const char* name;
+    double frameMs = 0.0;
+    unsigned frameCount = 0;
+    double windowMs = 0.0;
+    double windowPeakMs = 0.0;
+    std::uint64_t windowCount = 0;
+};
+
+struct FrameStats {
+    std::vector<SectionAccum> accum;
+    std::vector<Profiler::Section> published;
+    std::array<float, Profiler::FRAME_HISTORY> frameMs{};
+    size_t frames = 0; // total; frameMs is a ring over the latest
+    std::uint64_t lastFrameEnd = 0;
+    std::uint64_t windowStart = 0;
+    unsigned windowFrames = 0;
+    std::vector<Ring*> rings;
+    std::vector<Event> events;
+
+    SectionAccum& section(const char* name) {
+        // The same literal may have different addresses in different translation units
+        for (SectionAccum& a : accum) {
+            if (a.name == name || std::strcmp(a.name, name) == 0) return a;
+        }
+        accum.push_back(SectionAccum{name});
+        return accum.back();
+    }
+};
+
+FrameStats& frameStats() {
+    static FrameStats s;
+    return s;
+}
+
+const std::uint64_t traceEpochNs = Profiler::nowNs();
+
+void writeJsonString(std::ostream& out, const char* s) {
+    out << '"';
+    for (; *s; ++s) {
+        if (*s == '"' || *s == '\\') out << '\\';
+        if (static_cast<unsigned char>(*s) >= 0x20) out << *s;
+    }
+    out << '"';
+}
+
+} // namespace
+
+std::uint64_t Profiler::nowNs() {
+    return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+void Profiler::record(const char* name, std::uint64_t startNs, std::uint64_t endNs) {
+    localRing().push(name, startNs, endNs);
+}
+
+void Profiler::setThreadName(const char* name) {
+    Ring& ring = localRing();
+    std::lock_guard<std::mutex> lock(registry().mutex);
+    ring.threadName = name;
+}
+
+void Profiler::endFrame() {
+    FrameStats& s = frameStats();
+    const std::uint64_t now = nowNs();
+    if (s.lastFrameEnd != 0) {
+        record("frame", s.lastFrameEnd, now);
+        s.frameMs[s.frames % FRAME_HISTORY] = static_cast<float>(static_cast<double>(now - s.lastFrameEnd) * 1e-6);
+        ++s.frames;
+    } else {
+        s.windowStart = now;
+    }
+    s.lastFrameEnd = now;
+
+    {
+        Registry& reg = registry();
+        std::lock_guard<std::mutex> lock(reg.mutex);
+        s.rings.clear();
+        for (const auto& r : reg.rings) s.rings.push_back(r.get());
+    }
+    for (Ring* ring : s.rings) {
+        s.events.clear();
+        ring->statsCursor = ring->read(ring->statsCursor, s.events);
+        for (const Event& e : s.events) {
+            SectionAccum& a = s.section(e.name);
+            a.frameMs += static_cast<double>(e.endNs - e.startNs) * 1e-6;
+            ++a.frameCount;
+        }
+    }
+
+    for (SectionAccum& a : s.accum) {
+        a.windowMs += a.frameMs;
+        a.windowPeakMs = std::max(a.windowPeakMs, a.frameMs);
+        a.windowCount += a.frameCount;
+        a.frameMs = 0.0;
+        a.frameCount = 0;
+    }
+    ++s.windowFrames;
+
+    if (static_cast<double>(now - s.windowStart) * 1e-9 < STATS_WINDOW_SECONDS) return;
+    s.published.clear();
+    for (SectionAccum& a : s.accum) {
+        s.published.push_back({a.name, a.windowMs / s.windowFrames, a.windowPeakMs,
+                               static_cast<double>(a.windowCount) / s.windowFrames});
+        a.windowMs = a.windowPeakMs = 0.0;
+        a.windowCount = 0;
+    }
+    s.windowStart = now;
+    s.windowFrames = 0;
+}
+
+const std::vector<Profiler::Section>& Profiler::sections() {
+    return frameStats().published;
+}
+
+std::vector<float> Profiler::frameTimes() {
+    const FrameStats& s = frameStats();
+    const size_t n = std::min(s.frames, FRAME_HISTORY);
+    std::vector<float> out;
+    out.reserve(n);
+    for (size_t i = s.frames - n; i < s.frames; ++i) out.push_back(s.frameMs[i % FRAME_HISTORY]);
+    return out;
+}
+
+bool Profiler::writeChromeTrace(const std::filesystem::path& file, double seconds) {
+    std::ofstream out(file);
+    if (!out) return false;
+
+    const std::uint64_t now = nowNs();
+    const std::uint64_t window = static_cast<std::uint64_t>(std::max(0.0, seconds) * 1e9);
+    const std::uint64_t cutoff = now > window ? now - window : 0;
+    auto micros = [](std::uint64_t ns) { return static_cast<double>(ns) * 1e-3; };
+
+    Registry& reg = registry();
+    std::lock_guard<std::mutex> lock(reg.mutex); // keeps tids and names still while we write
+    std::vector<Event> events;
+    char buf[96];
+    bool first = true;
+    auto separator = [&]() -> std::ostream& {
+        out << (first ? "\n" : ",\n");
+        first = false;
+        return out;
+    };
+
+    out << "{\"displayTimeUnit\": \"ms\", \"traceEvents\": [";
+    for (const auto& ring : reg.rings) {
+        separator() << "{\"name\": \"thread_name\", \"ph\": \"M\", \"pid\": 1, \"tid\": " << ring->tid
+                    << ", \"args\": {\"name\": ";
+        if (ring->threadName.empty()) {
+            std::snprintf(buf, sizeof(buf), "thread %u", ring->tid);
+            writeJsonString(out, buf);
+        } else {
+            writeJsonString(out, ring->threadName.c_str());
+        }
+        out << "}}";
+
+        events.clear();
+        ring->read(0, events);
+        for (const Event& e : events) {
+            if (e.endNs < cutoff || e.startNs < traceEpochNs) continue;
+            separator() << "{\"name\": ";
+            writeJsonString(out, e.name);
+            std::snprintf(buf, sizeof(buf), ", \"ph\": \"X\", \"ts\": %.3f, \"dur\": %.3f, \"pid\": 1, \"tid\": %u}",
+                          micros(e.startNs - traceEpochNs), micros(e.endNs - e.startNs), ring->tid);
+            out << buf;
+        }
+    }
+    out << "\n]}\n";
+    return static_cast<bool>(out);
+}
+
+#endif
@@ -0,0 +1,82 @@
+#pragma once
+
+// Frame profiler: scoped timers recorded into per-thread rings, folded into
+// per-frame section stats for the HUD, and exportable as a Chrome trace
+// (chrome://tracing, Perfetto).
+//
+// Instrument code with the macros only. With WET_PROFILE off (CMake option) they
+// expand to nothing and none of this is compiled.
+//
+//   WET_PROFILE_SCOPE("world.ensureVisible"); // times the rest of the enclosing block
+//   WET_PROFILE_THREAD("worker");             // names the calling thread in traces
+//   WET_PROFILE_FRAME();                      // main thread, once per frame
+#ifndef WET_PROFILE
+#define WET_PROFILE 0
+#endif
+
+#if WET_PROFILE
+#include <cstdint>
+#include <filesystem>
+#include <vector>
+
+class Profiler {
+public:
+    // Section names are stored by pointer, so they must outlive the program: string literals
+    static void record(const char* name, std::uint64_t startNs, std::uint64_t endNs);
+    static void setThreadName(const char* name);
+    static std::uint64_t nowNs(); // steady clock
+
+    // Main thread, once per frame: closes the frame and folds every thread's new
+    // events into the section stats
+    static void endFrame();
+
+    // Per-section figures over the last STATS_WINDOW_SECONDS, in first-seen order.
+    // Times are inclusive (a nested section also counts in its parent). Sections
+    // recorded on worker threads are attributed to the frame in which they finished.
+    struct Section {
+        const char* name;
+        double avgMs;         // per frame
+        double peakMs;        // worst single frame
+        double countPerFrame;
+    };
+    static constexpr double STATS_WINDOW_SECONDS = 0.5;
+    static const std::vector<Section>& sections();
+
+    // Frame times in ms, oldest first, FRAME_HISTORY entries at most
+    static constexpr size_t FRAME_HISTORY = 240;
+    static std::vector<float> frameTimes();
+
+    // Events of every thread that ended within the last `seconds`, as Chrome trace
+    // JSON. Each thread keeps its latest RING_EVENTS events, which bounds how far
+    // back a busy thread reaches. Returns false if the file can't be written.
+    static constexpr size_t RING_EVENTS = size_t(1) << 16;
+    static bool writeChromeTrace(const std::filesystem::path& file, double seconds);
+};
+
+// Records [construction, destruction) under name
+class ProfileScope {
+public:
+    explicit ProfileScope(const char* name) : name_(name), start_(Profiler::nowNs()) {}
+    ~ProfileScope() { Profiler::record(name_, start_, Profiler::nowNs()); }
+
+    ProfileScope(const ProfileScope&) = delete;
+    ProfileScope& operator=(const ProfileScope&) = delete;
+
+private:
+    const char* name_;
+    std::uint64_t start_;
+};
+
+#define WET_PROFILE_CAT_(a, b) a##b
+#define WET_PROFILE_CAT(a, b) WET_PROFILE_CAT_(a, b)
+#define WET_PROFILE_SCOPE(name) ProfileScope WET_PROFILE_CAT(wetProfileScope_, __LINE__)(name)
+#define WET_PROFILE_THREAD(name) Profiler::setThreadName(name)
+#define WET_PROFILE_FRAME() Profiler::endFrame()
+
+#else
+
+#define WET_PROFILE_SCOPE(name) ((void)0)
+#define WET_PROFILE_THREAD(name) ((void)0)
+#define WET_PROFILE_FRAME() ((void)0)
+
+#endif
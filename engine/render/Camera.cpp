@@ -63,6 +63,7 @@ void Camera::update(float dt) {
     
     // Current position for bounds checking
     const sf::Vector2f currentCenter = view_.getCenter();
+    const float currentWidth = view_.getSize().x;
     constexpr float maxWorldCoord = 1000000.f; // Reasonable world limit
     
     // Apply movement with bounds checking
@@ -86,4 +87,10 @@ void Camera::update(float dt) {
         const float zoomFactor = std::min(1000.f, 1.f + zoomStep_);
         view_.zoom(zoomFactor);
     }
+
+    // Track motion for predictive chunk loading
+    if (dt > 0.f) {
+        velocity_ = (view_.getCenter() - currentCenter) / dt;
+        zoomRate_ = std::log(view_.getSize().x / currentWidth) / dt;
+    }
 }
@@ -24,8 +24,15 @@ public:
 
     const sf::View& view() const { return view_; }
 
+    // Motion over the last update: pan in pixels/second, zoom as d(ln viewSize)/dt
+    // (positive while zooming out)
+    sf::Vector2f velocity() const { return velocity_; }
+    float zoomRate() const { return zoomRate_; }
+
 private:
     sf::View view_;
+    sf::Vector2f velocity_{0.f, 0.f};
+    float zoomRate_ = 0.f;
     float panSpeed_ = 300.f;  // pixels/second
     float zoomStep_ = 0.01f;  // multiplicative step per update when held
 
@@ -0,0 +1,68 @@
+#include "engine/render/ProfilerOverlay.hpp"
+
+#if WET_PROFILE
+#include <algorithm>
+#include <cstdio>
+
+namespace {
+constexpr float PADDING = 6.f;
+
+void appendQuad(sf::VertexArray& va, sf::Vector2f min, sf::Vector2f max, sf::Color color) {
+    const sf::Vector2f a = min, b{max.x, min.y}, c = max, d{min.x, max.y};
+    for (sf::Vector2f p : {a, b, c, a, c, d}) va.append(sf::Vertex{p, color});
+}
+} // namespace
+
+ProfilerOverlay::ProfilerOverlay(const sf::Font& font) : text_(font, "", 13) {
+    text_.setFillColor(sf::Color::White);
+    panel_.setFillColor(sf::Color(0, 0, 0, 170));
+}
+
+void ProfilerOverlay::update() {
+    if (!visible_) return;
+
+    char line[128];
+    lines_ = "section                     avg ms   peak ms   /frame\n";
+    for (const Profiler::Section& s : Profiler::sections()) {
+        std::snprintf(line, sizeof(line), "%-26s %8.2f %9.2f %8.1f\n", s.name, s.avgMs, s.peakMs, s.countPerFrame);
+        lines_ += line;
+    }
+    text_.setString(lines_);
+    text_.setPosition(position_ + sf::Vector2f{PADDING, PADDING});
+
+    // Frame-time bars, newest on the right: green within 60 fps, then yellow, red past 30 fps
+    const std::vector<float> frames = Profiler::frameTimes();
+    const float graphWidth = BAR_WIDTH * static_cast<float>(Profiler::FRAME_HISTORY);
+    const sf::Vector2f graphMin = position_ + sf::Vector2f{PADDING, PADDING * 2.f + text_.getLocalBounds().size.y};
+    const float baseline = graphMin.y + GRAPH_HEIGHT;
+    graph_.clear();
+    float x = graphMin.x + graphWidth - BAR_WIDTH * static_cast<float>(frames.size());
+    for (float ms : frames) {
+        const float h = GRAPH_HEIGHT * std::min(ms, GRAPH_MAX_MS) / GRAPH_MAX_MS;
+        const sf::Color color = ms <= 1000.f / 60.f ? sf::Color(80, 220, 80)
+                              : ms <= 1000.f / 30.f ? sf::Color(230, 200, 60)
+                                                    : sf::Color(230, 70, 60);
+        appendQuad(graph_, {x, baseline - h}, {x + BAR_WIDTH, baseline}, color);
+        x += BAR_WIDTH;
+    }
+
+    guides_.clear();
+    for (float ms : {1000.f / 60.f, 1000.f / 144.f}) {
+        const float y = baseline - GRAPH_HEIGHT * ms / GRAPH_MAX_MS;
+        guides_.append(sf::Vertex{{graphMin.x, y}, sf::Color(255, 255, 255, 110)});
+        guides_.append(sf::Vertex{{graphMin.x + graphWidth, y}, sf::Color(255, 255, 255, 110)});
+    }
+
+    const float width = std::max(graphWidth, text_.getLocalBounds().size.x) + PADDING * 2.f;
+    panel_.setPosition(position_);
+    panel_.setSize({width, baseline + PADDING - position_.y});
+}
+
+void ProfilerOverlay::draw(sf::RenderTarget& target, sf::RenderStates states) const {
+    if (!visible_) return;
+    target.draw(panel_, states);
+    target.draw(graph_, states);
+    target.draw(guides_, states);
+    target.draw(text_, states);
+}
+#endif
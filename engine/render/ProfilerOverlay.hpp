@@ -0,0 +1,37 @@
+#pragma once
+#include "engine/profile/Profiler.hpp"
+
+#if WET_PROFILE
+#include <SFML/Graphics.hpp>
+#include <string>
+
+// HUD panel for the frame profiler: each section's average and worst-frame ms and
+// calls per frame over the stats window, above a graph of recent frame times.
+// Draw it with the default (screen) view.
+class ProfilerOverlay : public sf::Drawable {
+public:
+    explicit ProfilerOverlay(const sf::Font& font);
+
+    // Pull the latest figures; call once per frame after WET_PROFILE_FRAME()
+    void update();
+
+    void setPosition(sf::Vector2f position) { position_ = position; }
+    bool visible() const { return visible_; }
+    void toggle() { visible_ = !visible_; }
+
+private:
+    static constexpr float GRAPH_HEIGHT = 80.f;  // px
+    static constexpr float GRAPH_MAX_MS = 40.f;  // top of the graph
+    static constexpr float BAR_WIDTH = 2.f;      // px per frame
+
+    void draw(sf::RenderTarget& target, sf::RenderStates states) const override;
+
+    sf::Text text_;
+    std::string lines_; // reused between updates
+    sf::RectangleShape panel_;
+    sf::VertexArray graph_{sf::PrimitiveType::Triangles};
+    sf::VertexArray guides_{sf::PrimitiveType::Lines}; // 60 and 144 fps
+    sf::Vector2f position_{8.f, 80.f};
+    bool visible_ = false;
+};
+#endif
@@ -0,0 +1,45 @@
+#include "engine/tile/BackgroundBatch.hpp"
+#include "engine/tile/Coords.hpp"
+#include "engine/tile/Terrain.hpp"
+#include <algorithm>
+
+sf::Color BackgroundBatch::wallColor(int depthBelowSurface) {
+    // Depth-based background color
+    const float depthFactor = std::min(0.8f, static_cast<float>(depthBelowSurface) / 60.0f);
+    return sf::Color(static_cast<std::uint8_t>(25 + depthFactor * 20),
+                     static_cast<std::uint8_t>(20 + depthFactor * 15),
+                     static_cast<std::uint8_t>(15 + depthFactor * 10),
+                     255); // Fully opaque underground background
+}
+
+void BackgroundBatch::build(const Chunk& chunk, const SurfaceStrip& surface) {
+    va_.clear();
+    published_.invalidate();
+
+    const auto orgTiles = chunkOriginTiles(chunk.coord());
+    pixelOffset_ = {orgTiles.x * static_cast<float>(TILE_SIZE),
+                    orgTiles.y * static_cast<float>(TILE_SIZE)};
+    const float S = static_cast<float>(TILE_SIZE);
+
+    for (unsigned x = 0; x < CHUNK_W; ++x) {
+        // Only air below the generated surface is underground
+        const int surfaceTileY = surface[x];
+        const unsigned firstY = static_cast<unsigned>(std::clamp(surfaceTileY + 1 - orgTiles.y, 0,
+                                                                 static_cast<int>(CHUNK_H)));
+
+        for (unsigned y = firstY; y < CHUNK_H; ++y) {
+            if (chunk.getUnchecked(x, y) != Tile::Air) continue;
+
+            const sf::Color color = wallColor(orgTiles.y + static_cast<int>(y) - surfaceTileY);
+
+            const float x0 = x * S, y0 = y * S, x1 = x0 + S, y1 = y0 + S;
+            va_.push_back({{x0, y0}, color, {}});
+            va_.push_back({{x1, y0}, color, {}});
+            va_.push_back({{x1, y1}, color, {}});
+            va_.push_back({{x0, y0}, color, {}});
+            va_.push_back({{x1, y1}, color, {}});
+            va_.push_back({{x0, y1}, color, {}});
+        }
+    }
+    isDirty_ = false;
+}
@@ -0,0 +1,43 @@
+#pragma once
+#include <SFML/Graphics.hpp>
+#include <vector>
+#include "engine/tile/Chunk.hpp"
+#include "engine/tile/Terrain.hpp"
+#include "engine/tile/MeshSnapshot.hpp"
+
+// Cave wall layer behind a chunk: one untextured quad per underground air tile,
+// shaded darker with depth below the terrain surface. Drawn in a single call and
+// rebuilt only when a tile turns into air or stops being air.
+class BackgroundBatch : public sf::Drawable {
+public:
+    // surface: the generated surface of the chunk's columns
+    void build(const Chunk& chunk, const SurfaceStrip& surface);
+
+    // Wall colour for air this many tiles below the surface (also used by imposters)
+    static sf::Color wallColor(int depthBelowSurface);
+
+    size_t memoryBytes() const { return va_.capacity() * sizeof(sf::Vertex); }
+    size_t vertexCount() const { return va_.size(); }
+
+    // Drop the mesh but keep the vertex buffer for reuse
+    void clear() { va_.clear(); isDirty_ = false; published_.invalidate(); }
+
+    // Append a read-only copy of the mesh, made once per change
+    void publish(std::vector<MeshHandle>& out) { published_.publish(out, va_, pixelOffset_, nullptr, /*lit=*/false); }
+    void dropSnapshot() { published_.invalidate(); }
+
+    bool isDirty() const { return isDirty_; }
+    void markDirty() { isDirty_ = true; }
+
+private:
+    std::vector<sf::Vertex> va_;                  // triangles, untextured
+    sf::Vector2f            pixelOffset_{0.f, 0.f};
+    bool                    isDirty_ = false;
+    MeshPublisher           published_;
+
+    void draw(sf::RenderTarget& t, sf::RenderStates s) const override {
+        s.transform.translate(pixelOffset_);
+        s.texture = nullptr;
+        if (!va_.empty()) t.draw(va_.data(), va_.size(), sf::PrimitiveType::Triangles, s);
+    }
+};
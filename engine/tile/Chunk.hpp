@@ -2,75 +2,122 @@
 #include <vector>
 #include <cmath>
 #include <algorithm>
+#include <limits>
 #include <cstdint>
 #include "engine/tile/TileTypes.hpp"
 #include "engine/tile/Coords.hpp"
 #include "engine/noise/ValueNoise.hpp"
 #include "engine/tile/LightMap.hpp"
+#include "engine/tile/Terrain.hpp"
+#include "engine/tile/TileStorage.hpp"
 
+// CHUNK_W x CHUNK_H tiles. The size is fixed at compile time, so indexing is a
+// shift and an add and loops over a chunk have constant trip counts.
 class Chunk {
 public:
-    Chunk(ChunkCoord cc, unsigned w = CHUNK_W, unsigned h = CHUNK_H)
-        : coord_(cc), w_(w), h_(h), data_(w_*h_, Tile::Air), lightMap_(w, h) {}
+    explicit Chunk(ChunkCoord cc) : coord_(cc), tiles_(CHUNK_TILES, Tile::Air) {}
 
-    unsigned width()  const { return w_; }
-    unsigned height() const { return h_; }
+    // Reuse this chunk's buffers for another coordinate; tiles must be regenerated or loaded
+    void reset(ChunkCoord cc) {
+        coord_ = cc;
+        lightingDirty_ = true;
+    }
+
+    static constexpr unsigned width()  { return CHUNK_W; }
+    static constexpr unsigned height() { return CHUNK_H; }
     ChunkCoord coord() const { return coord_; }
+    size_t memoryBytes() const { return tiles_.memoryBytes() + lightMap_.memoryBytes(); }
 
     TileID get(unsigned x, unsigned y) const { 
-        if (x >= w_ || y >= h_) return Tile::Air;
-        return data_[y*w_ + x]; 
+        if (x >= CHUNK_W || y >= CHUNK_H) return Tile::Air;
+        return tiles_.get(chunkTileIndex(x, y));
     }
     void   set(unsigned x, unsigned y, TileID id) { 
-        if (x >= w_ || y >= h_) return;
-        data_[y*w_ + x] = id; 
+        if (x >= CHUNK_W || y >= CHUNK_H) return;
+        tiles_.set(chunkTileIndex(x, y), id);
         lightingDirty_ = true; // mark lighting as needing recalculation
     }
 
+    // For loops that already stay inside the chunk: no bounds check, and setting
+    // leaves the lighting flag to the caller
+    TileID getUnchecked(unsigned x, unsigned y) const { return tiles_.get(chunkTileIndex(x, y)); }
+    void   setUnchecked(unsigned x, unsigned y, TileID id) { tiles_.set(chunkTileIndex(x, y), id); }
+
+    // Nothing but air: no lighting or mesh beyond the sky seeds
+    bool isAllAir() const { return tiles_.isUniform() && tiles_.uniformValue() == Tile::Air; }
+    const TileStorage& storage() const { return tiles_; }
+
+    // Row-major tile array (CHUNK_TILES entries), for persistence, lighting and meshing
+    void copyTiles(TileID* out) const { tiles_.copyTo(out); }
+    void loadTiles(const TileID* src) {
+        tiles_.assign(src);
+        lightingDirty_ = true;
+    }
+
     const LightMap& getLightMap() const { return lightMap_; }
-    void updateLighting(unsigned ambientLight = 0) {
+    // Mutable access for the world's incremental light engine, which keeps the
+    // map current itself and then clears the dirty flag
+    LightMap& getLightMap() { return lightMap_; }
+    void markLightingCurrent() { lightingDirty_ = false; }
+    bool isLightingDirty() const { return lightingDirty_; }
+    void updateLighting() {
         if (lightingDirty_) {
-            lightMap_.calculateLighting(*this, ambientLight);
+            lightMap_.calculateLighting(*this);
             lightingDirty_ = false;
         }
     }
 
-    void generate(unsigned seed = 0) {
-        const float mid  = h_ * 0.55f;
-        const float amp  = h_ * 0.18f;
-        const float wavL = 180.f; // tiles
-        const float twoPi = 6.28318530718f;
-        const float freq = twoPi / wavL;
-
+    // surface: the generated surface of this chunk's columns if the caller has it
+    // (see World's SurfaceCache); computed here otherwise
+    void generate(unsigned seed = 0, const SurfaceStrip* surface = nullptr) {
         const auto org = chunkOriginTiles(coord_); // in tiles
 
-        // Surface-first pass
-        std::vector<int> surfaceCol(w_, 0);
-        for (unsigned lx = 0; lx < w_; ++lx) {
-            const int worldX = org.x + static_cast<int>(lx);
-            const float f = mid + amp * std::sin(freq * static_cast<float>(worldX));
-            const int surface = static_cast<int>(std::floor(f));
-            surfaceCol[lx] = surface;
+        // Terrain and caves first, into a flat array that is packed in one go
+        // (per-thread scratch so repeated generation doesn't allocate)
+        thread_local std::vector<int> surfaceCol;
+        thread_local std::vector<float> noiseX, noiseY, noise;
+        thread_local std::vector<TileID> terrain;
+        surfaceCol.assign(CHUNK_W, 0);
+        int minSurface = std::numeric_limits<int>::max();
+        for (unsigned lx = 0; lx < CHUNK_W; ++lx) {
+            surfaceCol[lx] = surface ? (*surface)[lx] : terrainSurfaceY(org.x + static_cast<int>(lx));
+            minSurface = std::min(minSurface, surfaceCol[lx]);
+        }
+
+        // Cave noise for every row deep enough to have caves in some column, as one block
+        const unsigned firstCaveRow = static_cast<unsigned>(
+            std::clamp(minSurface + CAVE_MIN_DEPTH - org.y, 0, static_cast<int>(CHUNK_H)));
+        const unsigned caveRows = CHUNK_H - firstCaveRow;
+        if (caveRows > 0) {
+            noiseX.resize(CHUNK_W);
+            noiseY.resize(caveRows);
+            noise.resize(size_t(CHUNK_W) * caveRows);
+            for (unsigned lx = 0; lx < CHUNK_W; ++lx) noiseX[lx] = caveNoiseX(org.x + static_cast<int>(lx));
+            for (unsigned r = 0; r < caveRows; ++r) noiseY[r] = caveNoiseY(org.y + static_cast<int>(firstCaveRow + r));
+            fbm2Grid(noiseX.data(), CHUNK_W, noiseY.data(), caveRows, static_cast<std::uint64_t>(seed) ^ CAVE_SALT,
+                     noise.data(), /*octaves=*/4, /*lacunarity=*/2.0f, /*gain=*/0.5f);
+        }
 
-            for (unsigned ly = 0; ly < h_; ++ly) {
-                const int worldY = org.y + static_cast<int>(ly);
-                TileID t = Tile::Air;
-                if (worldY == surface)              t = Tile::Grass;
-                else if (worldY > surface && worldY <= surface + 4) t = Tile::Dirt;
-                else if (worldY > surface + 4)      t = Tile::Stone;
-                set(lx, ly, t);
+        terrain.resize(CHUNK_TILES);
+        for (unsigned ly = 0; ly < CHUNK_H; ++ly) {
+            const int worldY = org.y + static_cast<int>(ly);
+            const float* noiseRow = ly >= firstCaveRow ? noise.data() + size_t(ly - firstCaveRow) * CHUNK_W : nullptr;
+            TileID* row = terrain.data() + size_t(ly) * CHUNK_W;
+            for (unsigned lx = 0; lx < CHUNK_W; ++lx) {
+                row[lx] = terrainTile(worldY, surfaceCol[lx], noiseRow ? noiseRow[lx] : 0.f);
             }
         }
+        tiles_.assign(terrain.data());
 
         // Tree placement pass — place different tree types after basic terrain
-        for (unsigned lx = 0; lx < w_; ++lx) {
+        for (unsigned lx = 0; lx < CHUNK_W; ++lx) {
             const int worldX = org.x + static_cast<int>(lx);
             const int surf = surfaceCol[lx];
             
             // Only place trees on grass surface, with some spacing
-            if (lx < w_ - 1) { // need space for tree
+            if (lx < CHUNK_W - 1) { // need space for tree
                 const unsigned ly = static_cast<unsigned>(std::max(0, surf - org.y));
-                if (ly < h_ && get(lx, ly) == Tile::Grass) {
+                if (ly < CHUNK_H && getUnchecked(lx, ly) == Tile::Grass) {
                     // Use world coordinates for consistent tree placement
                     const std::uint64_t treeHash = hash2to1(static_cast<std::uint64_t>(worldX), static_cast<std::uint64_t>(seed));
                     
@@ -97,37 +144,6 @@ public:
             }
         }
 
-        // Cave carving pass — deterministic FBM per world tile
-        // Only carve in deep dirt/stone; spare the top band for stability
-        const float baseFreq = 1.0f / 22.0f; // larger -> more caves
-        for (unsigned lx = 0; lx < w_; ++lx) {
-            const int worldX = org.x + static_cast<int>(lx);
-            const int surf   = surfaceCol[lx];
-
-            for (unsigned ly = 0; ly < h_; ++ly) {
-                const int worldY = org.y + static_cast<int>(ly);
-                TileID t = get(lx, ly);
-                if (t == Tile::Air) continue;
-
-                const int depthBelowSurface = worldY - surf;
-                if (depthBelowSurface < 6) continue; // keep top layers solid
-
-                // FBM noise; deeper -> more caverns (lower threshold)
-                const float nx = static_cast<float>(worldX) * baseFreq;
-                const float ny = static_cast<float>(worldY) * baseFreq * 0.8f;
-                constexpr std::uint64_t CAVE_SALT = 0xC0FFEE5EEDULL; // valid hex, 64-bit
-                float n = fbm2(nx, ny, static_cast<std::uint64_t>(seed) ^ CAVE_SALT,
-                /*octaves=*/4, 
-                /*lacunarity=*/2.0f, 
-                /*gain=*/0.5f);                
-                // depth factor 0..1 over ~80 tiles
-                const float d = std::clamp(depthBelowSurface / 80.f, 0.f, 1.f);
-                const float threshold = 0.62f - 0.25f * d; // deeper => more carve
-                if (n > threshold) continue; // keep solid
-                set(lx, ly, Tile::Air);
-            }
-        }
-        
         // Mark lighting as dirty after generation
         lightingDirty_ = true;
     }
@@ -141,7 +157,7 @@ private:
         // Place trunk
         for (unsigned i = 0; i < trunkHeight; ++i) {
             if (baseY > i) {
-                set(baseX, baseY - i - 1, Tile::Wood);
+                setUnchecked(baseX, baseY - i - 1, Tile::Wood);
             }
         }
         
@@ -152,12 +168,12 @@ private:
                 const int leafX = static_cast<int>(baseX) + dx;
                 const int leafY = static_cast<int>(crownCenterY) + dy;
                 
-                if (leafX >= 0 && leafX < static_cast<int>(w_) && leafY >= 0 && leafY < static_cast<int>(h_)) {
+                if (leafX >= 0 && leafX < static_cast<int>(CHUNK_W) && leafY >= 0 && leafY < static_cast<int>(CHUNK_H)) {
                     // Create natural gaps - skip corners and some random positions
                     if ((std::abs(dx) == 2 && std::abs(dy) == 2)) continue; // corners
                     if (((treeSeed + dx + dy) & 0x7) == 0) continue; // random gaps
                     
-                    set(static_cast<unsigned>(leafX), static_cast<unsigned>(leafY), Tile::Leaves);
+                    setUnchecked(static_cast<unsigned>(leafX), static_cast<unsigned>(leafY), Tile::Leaves);
                 }
             }
         }
@@ -169,7 +185,7 @@ private:
         // Place trunk
         for (unsigned i = 0; i < trunkHeight; ++i) {
             if (baseY > i) {
-                set(baseX, baseY - i - 1, Tile::Wood);
+                setUnchecked(baseX, baseY - i - 1, Tile::Wood);
             }
         }
         
@@ -181,10 +197,10 @@ private:
             
             for (unsigned dx = 0; dx < width; ++dx) {
                 // Place leaves on both sides
-                if (baseX >= dx && layerY < h_) {
-                    if (dx > 0) set(baseX - dx, layerY, Tile::Leaves);
-                    set(baseX, layerY, Tile::Leaves);
-                    if (baseX + dx < w_) set(baseX + dx, layerY, Tile::Leaves);
+                if (baseX >= dx && layerY < CHUNK_H) {
+                    if (dx > 0) setUnchecked(baseX - dx, layerY, Tile::Leaves);
+                    setUnchecked(baseX, layerY, Tile::Leaves);
+                    if (baseX + dx < CHUNK_W) setUnchecked(baseX + dx, layerY, Tile::Leaves);
                 }
             }
         }
@@ -196,7 +212,7 @@ private:
         // Place trunk
         for (unsigned i = 0; i < trunkHeight; ++i) {
             if (baseY > i) {
-                set(baseX, baseY - i - 1, Tile::Wood);
+                setUnchecked(baseX, baseY - i - 1, Tile::Wood);
             }
         }
         
@@ -209,10 +225,10 @@ private:
                 const int leafX = static_cast<int>(baseX) + dx;
                 const int leafY = static_cast<int>(crownTop) + dy;
                 
-                if (leafX >= 0 && leafX < static_cast<int>(w_) && leafY >= 0 && leafY < static_cast<int>(h_)) {
+                if (leafX >= 0 && leafX < static_cast<int>(CHUNK_W) && leafY >= 0 && leafY < static_cast<int>(CHUNK_H)) {
                     // Skip some corners for natural look
                     if (dy == 0 && std::abs(dx) == 2) continue;
-                    set(static_cast<unsigned>(leafX), static_cast<unsigned>(leafY), Tile::Leaves);
+                    setUnchecked(static_cast<unsigned>(leafX), static_cast<unsigned>(leafY), Tile::Leaves);
                 }
             }
         }
@@ -220,20 +236,19 @@ private:
         // More hanging droopy branches with varying lengths
         for (int dx = -3; dx <= 3; ++dx) { // wider spread
             const int branchX = static_cast<int>(baseX) + dx;
-            if (branchX >= 0 && branchX < static_cast<int>(w_)) {
+            if (branchX >= 0 && branchX < static_cast<int>(CHUNK_W)) {
                 // Longer drooping branches, especially in center
                 const unsigned branchLength = 4 + (treeSeed % 4) + (std::abs(dx) == 0 ? 2 : 0); // center branches longer
-                for (unsigned i = 0; i < branchLength && crownTop + 3 + i < h_; ++i) {
+                for (unsigned i = 0; i < branchLength && crownTop + 3 + i < CHUNK_H; ++i) {
                     // Skip some positions for natural gaps
                     if (((treeSeed + dx + i) & 0x3) == 0) continue;
-                    set(static_cast<unsigned>(branchX), crownTop + 3 + i, Tile::Leaves);
+                    setUnchecked(static_cast<unsigned>(branchX), crownTop + 3 + i, Tile::Leaves);
                 }
             }
         }
     }
     ChunkCoord coord_;
-    unsigned w_, h_;
-    std::vector<TileID> data_;
+    TileStorage tiles_;
     LightMap lightMap_;
     bool lightingDirty_ = true;
 };
@@ -51,6 +51,12 @@ inline ChunkCoord worldPixelsToChunk(float wx, float wy) {
     return {static_cast<ChunkX>(cx), static_cast<ChunkY>(cy)};
 }
 
+// World tile -> chunk coords (floor division, so negative tiles map correctly)
+inline ChunkCoord tileToChunk(int tx, int ty) {
+    auto floorDiv = [](int a, int b) { return (a >= 0) ? (a / b) : ((a - b + 1) / b); };
+    return {floorDiv(tx, static_cast<int>(CHUNK_W)), floorDiv(ty, static_cast<int>(CHUNK_H))};
+}
+
 // chunk origin in world tiles with overflow protection
 inline sf::Vector2i chunkOriginTiles(ChunkCoord c) {
     // Check for potential overflow before multiplication
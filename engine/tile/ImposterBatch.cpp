@@ -0,0 +1,113 @@
+#include "engine/tile/ImposterBatch.hpp"
+#include "engine/tile/BackgroundBatch.hpp"
+#include "engine/tile/Terrain.hpp"
+#include <algorithm>
+#include <limits>
+#include <vector>
+
+void ImposterBatch::generate(ChunkCoord coord, unsigned level, unsigned seed) {
+    coord_ = coord;
+    level_ = level;
+    cells_.resize(size_t(CHUNK_W) * CHUNK_H);
+
+    // World tiles: the imposter's origin and the block each cell stands for
+    const int block = 1 << level;
+    const int x0 = coord.x * static_cast<int>(CHUNK_W) * block;
+    const int y0 = coord.y * static_cast<int>(CHUNK_H) * block;
+
+    // Each cell samples the centre of its block
+    thread_local std::vector<int> surfaceCol;
+    thread_local std::vector<float> noiseX, noiseY, noise;
+    surfaceCol.resize(CHUNK_W);
+    int minSurface = std::numeric_limits<int>::max();
+    for (unsigned cx = 0; cx < CHUNK_W; ++cx) {
+        surfaceCol[cx] = terrainSurfaceY(x0 + static_cast<int>(cx) * block + block / 2);
+        minSurface = std::min(minSurface, surfaceCol[cx]);
+    }
+
+    // Cave noise for the rows deep enough to need it, as one block
+    unsigned firstCaveRow = 0;
+    while (firstCaveRow < CHUNK_H &&
+           y0 + static_cast<int>(firstCaveRow) * block + block / 2 < minSurface + CAVE_MIN_DEPTH) ++firstCaveRow;
+    const unsigned caveRows = CHUNK_H - firstCaveRow;
+    if (caveRows > 0) {
+        noiseX.resize(CHUNK_W);
+        noiseY.resize(caveRows);
+        noise.resize(size_t(CHUNK_W) * caveRows);
+        for (unsigned cx = 0; cx < CHUNK_W; ++cx) noiseX[cx] = caveNoiseX(x0 + static_cast<int>(cx) * block + block / 2);
+        for (unsigned r = 0; r < caveRows; ++r) {
+            noiseY[r] = caveNoiseY(y0 + static_cast<int>(firstCaveRow + r) * block + block / 2);
+        }
+        fbm2Grid(noiseX.data(), CHUNK_W, noiseY.data(), caveRows, static_cast<std::uint64_t>(seed) ^ CAVE_SALT,
+                 noise.data(), /*octaves=*/4, /*lacunarity=*/2.0f, /*gain=*/0.5f);
+    }
+
+    for (unsigned cy = 0; cy < CHUNK_H; ++cy) {
+        const int top = y0 + static_cast<int>(cy) * block;
+        const int worldY = top + block / 2;
+        const float* noiseRow = cy >= firstCaveRow ? noise.data() + size_t(cy - firstCaveRow) * CHUNK_W : nullptr;
+
+        for (unsigned cx = 0; cx < CHUNK_W; ++cx) {
+            const int surface = surfaceCol[cx];
+            Cell& cell = cells_[size_t(cy) * CHUNK_W + cx];
+
+            // The block holding the surface shows grass, so thin ground survives sampling
+            if (top + block <= surface)   cell.tile = Tile::Air;
+            else if (top <= surface)      cell.tile = Tile::Grass;
+            else                          cell.tile = terrainTile(worldY, surface, noiseRow ? noiseRow[cx] : 0.f);
+            cell.depth = static_cast<std::int16_t>(std::clamp(worldY - surface,
+                                                              int(std::numeric_limits<std::int16_t>::min()),
+                                                              int(std::numeric_limits<std::int16_t>::max())));
+        }
+    }
+    isDirty_ = true;
+}
+
+void ImposterBatch::build(const TileAtlas& atlas, const LightShader& light, unsigned ambient) {
+    va_.clear();
+    walls_.clear();
+    publishedWalls_.invalidate();
+    publishedTiles_.invalidate();
+    tex_ = &atlas.texture();
+
+    const int block = 1 << level_;
+    const auto orgTiles = chunkOriginTiles(ChunkCoord{coord_.x * block, coord_.y * block});
+    pixelOffset_ = {orgTiles.x * static_cast<float>(TILE_SIZE),
+                    orgTiles.y * static_cast<float>(TILE_SIZE)};
+    const float S = static_cast<float>(TILE_SIZE) * static_cast<float>(block);
+
+    auto quad = [](std::vector<sf::Vertex>& va, float x0, float y0, float s, sf::Color color,
+                   float u0, float v0, float u1, float v1) {
+        const float x1 = x0 + s, y1 = y0 + s;
+        va.push_back({{x0, y0}, color, {u0, v0}});
+        va.push_back({{x1, y0}, color, {u1, v0}});
+        va.push_back({{x1, y1}, color, {u1, v1}});
+        va.push_back({{x0, y0}, color, {u0, v0}});
+        va.push_back({{x1, y1}, color, {u1, v1}});
+        va.push_back({{x0, y1}, color, {u0, v1}});
+    };
+
+    for (unsigned cy = 0; cy < CHUNK_H; ++cy) {
+        for (unsigned cx = 0; cx < CHUNK_W; ++cx) {
+            const Cell& cell = cells_[size_t(cy) * CHUNK_W + cx];
+            const float x = cx * S, y = cy * S;
+
+            if (cell.tile == Tile::Air) {
+                if (cell.depth > 0) quad(walls_, x, y, S, BackgroundBatch::wallColor(cell.depth), 0.f, 0.f, 0.f, 0.f);
+                continue;
+            }
+
+            // No light map out here: sky reaches blocks that start at or above the
+            // surface, the rest is underground
+            const int worldY = orgTiles.y + static_cast<int>(cy) * block + block / 2;
+            const unsigned sky = cell.depth - block / 2 <= 0 ? MAX_LIGHT_LEVEL : 0;
+            const sf::Color color = light.vertexColor(0, sky, cell.tile == Tile::Stone && worldY >= 8, ambient);
+
+            const sf::IntRect uv = atlas.uvFor(cell.tile);
+            quad(va_, x, y, S, color,
+                 static_cast<float>(uv.position.x), static_cast<float>(uv.position.y),
+                 static_cast<float>(uv.position.x + uv.size.x), static_cast<float>(uv.position.y + uv.size.y));
+        }
+    }
+    isDirty_ = false;
+}
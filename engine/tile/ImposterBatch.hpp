@@ -0,0 +1,67 @@
+#pragma once
+#include <SFML/Graphics.hpp>
+#include <vector>
+#include "engine/tile/Coords.hpp"
+#include "engine/tile/TileAtlas.hpp"
+#include "engine/tile/LightShader.hpp"
+#include "engine/tile/MeshSnapshot.hpp"
+#include "engine/tile/TileTypes.hpp"
+
+// Level-of-detail stand-in for zoomed-out views.
+//
+// An imposter at level k covers 2^k x 2^k chunks with the same cell grid as one
+// chunk (CHUNK_W x CHUNK_H), each cell standing for a 2^k x 2^k block of tiles and
+// showing one representative tile. Cells come straight from the terrain functions,
+// so no full chunks are generated; trees and edits are not shown. With the level
+// picked so a cell covers a few screen pixels, the number of imposters on screen,
+// and so vertex count and load cost, stays roughly constant as the view zooms out.
+class ImposterBatch : public sf::Drawable {
+public:
+    // coord: imposter coordinate at this level, i.e. chunk coordinate >> level
+    void generate(ChunkCoord coord, unsigned level, unsigned seed);
+    // Turn cells into quads; cheap next to generate, so ambient changes only remesh
+    void build(const TileAtlas& atlas, const LightShader& light, unsigned ambient);
+
+    ChunkCoord coord() const { return coord_; }
+    unsigned   level() const { return level_; }
+
+    size_t memoryBytes() const {
+        return cells_.capacity() * sizeof(Cell) + (va_.capacity() + walls_.capacity()) * sizeof(sf::Vertex);
+    }
+    size_t vertexCount() const { return va_.size() + walls_.size(); }
+
+    bool isDirty() const { return isDirty_; }
+    void markDirty() { isDirty_ = true; }
+
+    // Append read-only copies of the walls and tiles, in draw order, made once per build
+    void publish(std::vector<MeshHandle>& out) {
+        publishedWalls_.publish(out, walls_, pixelOffset_, nullptr, /*lit=*/false);
+        publishedTiles_.publish(out, va_, pixelOffset_, tex_, /*lit=*/true);
+    }
+
+private:
+    struct Cell {
+        TileID tile = Tile::Air;
+        std::int16_t depth = 0; // centre tile's depth below the surface, clamped
+    };
+
+    std::vector<Cell>       cells_;             // CHUNK_W x CHUNK_H, row-major
+    std::vector<sf::Vertex> va_;                // textured tiles
+    std::vector<sf::Vertex> walls_;             // untextured cave walls behind air
+    ChunkCoord              coord_{};
+    unsigned                level_ = 0;
+    sf::Vector2f            pixelOffset_{0.f, 0.f};
+    const sf::Texture*      tex_ = nullptr;
+    bool                    isDirty_ = false;
+    MeshPublisher           publishedWalls_, publishedTiles_;
+
+    void draw(sf::RenderTarget& t, sf::RenderStates s) const override {
+        s.transform.translate(pixelOffset_);
+        s.texture = nullptr;
+        sf::RenderStates wallStates = s;
+        wallStates.shader = nullptr; // wall colours are final
+        if (!walls_.empty()) t.draw(walls_.data(), walls_.size(), sf::PrimitiveType::Triangles, wallStates);
+        s.texture = tex_;
+        if (!va_.empty()) t.draw(va_.data(), va_.size(), sf::PrimitiveType::Triangles, s);
+    }
+};
@@ -1,106 +1,126 @@
 #include "engine/tile/LightMap.hpp"
 #include "engine/tile/Chunk.hpp"
 #include <algorithm>
+#include <array>
 #include <cmath>
+#include <cstdint>
 
-void LightMap::calculateLighting(const Chunk& chunk, unsigned ambientLight) {
-    // First pass: Set base lighting levels for all tiles
-    for (unsigned y = 0; y < h_; ++y) {
-        for (unsigned x = 0; x < w_; ++x) {
-            TileID tile = chunk.get(x, y);
-            
-            // Underground gets reasonable ambient lighting regardless of surface
-            // Surface gets full ambient, underground gets completely uniform lighting
-            if (y < 8) {
-                // Surface and near-surface - can be affected by shadows
-                setLight(x, y, std::max(2u, ambientLight / 4));
-            } else {
-                // Underground - gets completely uniform lighting (no variation)
-                setLight(x, y, 7u); // Fixed uniform lighting level for all underground areas
-            }
-        }
+namespace {
+// Sky exposure left after passing through a tile
+inline std::uint8_t skyBelow(TileID tile, std::uint8_t sky) {
+    if (tile == Tile::Leaves) return sky >= 2 ? sky - 2 : 0; // leaves only slightly reduce it
+    return blocksLight(tile) ? 0 : sky;                       // solid blocks stop it completely
+}
+
+// The chunk's tiles unpacked into per-thread scratch, for the whole-chunk passes
+const TileID* unpackedTiles(const Chunk& chunk) {
+    thread_local std::array<TileID, CHUNK_TILES> tiles;
+    chunk.copyTiles(tiles.data());
+    return tiles.data();
+}
+} // namespace
+
+void LightMap::materialize() {
+    if (!isFlat()) return;
+    levels_.resize(CHUNK_TILES);
+    for (size_t y = 0; y < CHUNK_H; ++y) std::copy(skyAbove_.begin(), skyAbove_.end(), levels_.begin() + y * CHUNK_W);
+}
+
+void LightMap::calculateLighting(const Chunk& chunk) {
+    if (chunk.isAllAir()) {
+        std::vector<std::uint8_t>().swap(levels_); // flat
+        return;
     }
-    
-    // Second pass: Add sunlight from top (only affects surface layers - stop at depth 8)
-    if (ambientLight > 0) {
-        for (unsigned x = 0; x < w_; ++x) {
-            unsigned currentLight = ambientLight;
-            for (unsigned y = 0; y < h_ && y < 8 && currentLight > 0; ++y) { // Stop sunlight at underground boundary
-                TileID tile = chunk.get(x, y);
-                
-                if (tile == Tile::Air) {
-                    setLight(x, y, std::max(getLight(x, y), currentLight));
-                } else if (tile == Tile::Leaves) {
-                    // Leaves get good lighting and only slightly reduce passing light
-                    setLight(x, y, std::max(getLight(x, y), currentLight));
-                    currentLight = std::max(currentLight / 2, currentLight - 2);
-                } else if (blocksLight(tile)) {
-                    // Surface blocks get good lighting but completely block sunlight from going deeper
-                    setLight(x, y, std::max(getLight(x, y), currentLight));
-                    currentLight = 0; // Solid blocks completely stop sunlight penetration
-                } else {
-                    setLight(x, y, std::max(getLight(x, y), currentLight));
-                }
-            }
+    materialize();
+    const TileID* tiles = unpackedTiles(chunk);
+    skyLighting(tiles);
+    blockLighting(tiles);
+}
+
+void LightMap::calculateSkyLighting(const Chunk& chunk) {
+    if (isFlat() && chunk.isAllAir()) return;
+    materialize();
+    skyLighting(unpackedTiles(chunk));
+}
+
+void LightMap::calculateBlockLighting(const Chunk& chunk) {
+    if (isFlat() && chunk.isAllAir()) return;
+    materialize();
+    blockLighting(unpackedTiles(chunk));
+}
+
+// Row-wise so the inner loops run over contiguous tiles and light bytes without
+// bounds checks; the compiler vectorizes them
+void LightMap::skyLighting(const TileID* chunkTiles) {
+    constexpr size_t w = CHUNK_W, h = CHUNK_H;
+    std::uint8_t* levels = levels_.data(); // local: byte stores would otherwise alias the member
+
+    // Exposure still travelling down each column
+    std::array<std::uint8_t, CHUNK_W> sky = skyAbove_;
+    std::uint8_t* s = sky.data();
+
+    for (size_t y = 0; y < h; ++y) {
+        const TileID* tiles = chunkTiles + y * w;
+        std::uint8_t* row = levels + y * w;
+        for (size_t x = 0; x < w; ++x) {
+            row[x] = static_cast<std::uint8_t>((row[x] & 0xF0) | s[x]);
+            s[x] = skyBelow(tiles[x], s[x]);
         }
     }
-    
-    // Third pass: Add light sources and propagate
-    for (unsigned y = 0; y < h_; ++y) {
-        for (unsigned x = 0; x < w_; ++x) {
-            TileID tile = chunk.get(x, y);
-            if (isLightSource(tile)) {
-                unsigned emission = getLightEmission(tile);
-                propagateLight(chunk, x, y, emission);
-            }
-        }
+}
+
+void LightMap::updateSkyColumn(const Chunk& chunk, unsigned x) {
+    if (x >= CHUNK_W) return;
+    if (isFlat()) {
+        if (chunk.isAllAir()) return; // reads skyAbove_ directly
+        materialize();
+    }
+    std::uint8_t sky = skyAbove_[x];
+    for (unsigned y = 0; y < CHUNK_H; ++y) {
+        std::uint8_t& b = levels_[chunkTileIndex(x, y)];
+        b = static_cast<std::uint8_t>((b & 0xF0) | sky);
+        sky = skyBelow(chunk.getUnchecked(x, y), sky);
     }
 }
 
-void LightMap::propagateLight(const Chunk& chunk, unsigned startX, unsigned startY, unsigned lightLevel) {
-    if (lightLevel <= 1) return; // No more light to propagate
-    
-    // Use flood-fill to propagate light
-    std::queue<std::tuple<unsigned, unsigned, unsigned>> queue;
-    queue.push({startX, startY, lightLevel});
-    
-    // Track visited positions to avoid infinite loops
-    std::vector<bool> visited(w_ * h_, false);
-    
-    while (!queue.empty()) {
-        auto [x, y, level] = queue.front();
-        queue.pop();
-        
-        if (x >= w_ || y >= h_) continue;
-        
-        size_t idx = y * w_ + x;
-        if (visited[idx]) continue;
-        visited[idx] = true;
-        
-        // Set light level (take maximum of current and new)
-        unsigned currentLight = getLight(x, y);
-        unsigned newLight = std::max(currentLight, level);
-        setLight(x, y, newLight);
-        
-        // Propagate to neighbors if we have light left
-        if (level > 1) {
-            TileID currentTile = chunk.get(x, y);
-            unsigned nextLevel = level - 1;
-            
-            // Reduce light more if passing through blocking materials
-            if (currentTile == Tile::Leaves) {
-                nextLevel = std::max(0u, nextLevel - 1); // leaves reduce light more
-            } else if (blocksLight(currentTile)) {
-                nextLevel = 0; // solid blocks stop light completely
-            }
-            
-            if (nextLevel > 0) {
-                // Add neighbors to queue
-                if (x > 0) queue.push({x-1, y, nextLevel});
-                if (x < w_-1) queue.push({x+1, y, nextLevel});
-                if (y > 0) queue.push({x, y-1, nextLevel});
-                if (y < h_-1) queue.push({x, y+1, nextLevel});
-            }
+void LightMap::blockLighting(const TileID* tiles) {
+    constexpr size_t w = CHUNK_W, h = CHUNK_H;
+    std::uint8_t* levels = levels_.data();
+
+    // One bucket of tile indices per light level (per-thread scratch, keeps its capacity)
+    thread_local std::array<std::vector<std::uint32_t>, MAX_LIGHT_LEVEL + 1> buckets;
+    for (auto& bucket : buckets) bucket.clear();
+
+    for (size_t i = 0; i < w * h; ++i) levels[i] &= 0x0F;
+
+    // Seed every emitter at once
+    for (size_t i = 0; i < w * h; ++i) {
+        if (!isLightSource(tiles[i])) continue;
+        const unsigned emission = std::min(getLightEmission(tiles[i]), MAX_LIGHT_LEVEL);
+        levels[i] = static_cast<std::uint8_t>((levels[i] & 0x0F) | (emission << 4));
+        buckets[emission].push_back(static_cast<std::uint32_t>(i));
+    }
+
+    // Brightest first. A tile popped at level L can't get brighter any more, so it is
+    // expanded exactly once; copies queued before it was raised are skipped as stale.
+    // Light only falls as it spreads, so a bucket never grows while it is drained.
+    for (unsigned level = MAX_LIGHT_LEVEL; level > 1; --level) {
+        const std::vector<std::uint32_t>& bucket = buckets[level];
+        for (const std::uint32_t i : bucket) {
+            if ((levels[i] >> 4) != level) continue;
+            const unsigned next = transmitLight(tiles[i], level);
+            if (next == 0) continue;
+
+            auto relax = [&](size_t n) {
+                if ((levels[n] >> 4) >= next) return;
+                levels[n] = static_cast<std::uint8_t>((levels[n] & 0x0F) | (next << 4));
+                buckets[next].push_back(static_cast<std::uint32_t>(n));
+            };
+            const size_t x = i % w;
+            if (x > 0)      relax(i - 1);
+            if (x + 1 < w)  relax(i + 1);
+            if (i >= w)     relax(i - w);
+            if (i + w < w * h) relax(i + w);
         }
     }
-}
\ No newline at end of file
+}
@@ -1,37 +1,103 @@
 #pragma once
+#include <array>
+#include <cstdint>
 #include <vector>
-#include <queue>
 #include <algorithm>
 #include "engine/tile/TileTypes.hpp"
 #include "engine/tile/Coords.hpp"
 
 class Chunk; // forward declaration
 
+// Per-tile light in two channels:
+//   sky   - sky exposure: how much of full daylight reaches the tile, independent
+//           of the time of day. Seeded per column by what enters through the top
+//           row (see setSkyAbove; the world derives it from its heightmap), then
+//           absorbed by leaves and stopped by solid tiles.
+//   block - light from emitters (torches, lanterns), which can cross chunk borders
+// Levels never exceed 15, so both channels share one byte per tile: sky in the low
+// nibble, block in the high one. combine() turns them into a light level for a
+// given ambient, so day/night never touches the map.
+//
+// An all-air chunk keeps no per-tile bytes at all ("flat"): nothing absorbs the sky
+// on the way down and nothing emits, so every tile reads its column's seed and no
+// block light. The map materializes as soon as light or tiles say otherwise.
 class LightMap {
 public:
-    LightMap(unsigned w = CHUNK_W, unsigned h = CHUNK_H) 
-        : w_(w), h_(h), lightLevels_(w*h, 0) {}
+    static constexpr unsigned UNDERGROUND_LIGHT = 7; // uniform light where no sky reaches
 
-    unsigned width() const { return w_; }
-    unsigned height() const { return h_; }
+    LightMap() { skyAbove_.fill(static_cast<std::uint8_t>(MAX_LIGHT_LEVEL)); }
 
-    unsigned getLight(unsigned x, unsigned y) const {
-        if (x >= w_ || y >= h_) return 0;
-        return lightLevels_[y*w_ + x];
+    static constexpr unsigned width()  { return CHUNK_W; }
+    static constexpr unsigned height() { return CHUNK_H; }
+    size_t memoryBytes() const { return levels_.capacity() + skyAbove_.size(); }
+    bool isFlat() const { return levels_.empty(); }
+
+    // Raw per-tile bytes (sky | block << 4, chunkTileIndex order) for loops over the
+    // whole chunk; null while flat, when every tile reads skyAbove(x) and no block light
+    const std::uint8_t* levels() const { return isFlat() ? nullptr : levels_.data(); }
+
+    // Light level of a tile at the given ambient (time of day). Sky-lit tiles lose
+    // what the tiles above absorbed and never drop below a dim floor; the rest
+    // get the uniform underground level. Block light shows through either way.
+    // TileBatch's shader mirrors this.
+    static unsigned combine(unsigned block, unsigned sky, unsigned ambient) {
+        unsigned base = UNDERGROUND_LIGHT;
+        if (sky > 0) {
+            ambient = std::min(ambient, MAX_LIGHT_LEVEL);
+            const unsigned absorbed = MAX_LIGHT_LEVEL - sky;
+            base = std::max(std::max(2u, ambient / 4), ambient > absorbed ? ambient - absorbed : 0u);
+        }
+        return std::max(block, base);
+    }
+    unsigned getLight(unsigned x, unsigned y, unsigned ambient) const {
+        if (x >= CHUNK_W || y >= CHUNK_H) return 0;
+        return combine(getBlockLight(x, y), getSkyLight(x, y), ambient);
     }
 
-    void setLight(unsigned x, unsigned y, unsigned level) {
-        if (x >= w_ || y >= h_) return;
-        lightLevels_[y*w_ + x] = std::min(level, MAX_LIGHT_LEVEL);
+    unsigned getSkyLight(unsigned x, unsigned y) const {
+        if (x >= CHUNK_W || y >= CHUNK_H) return 0;
+        if (isFlat()) return skyAbove_[x];
+        return levels_[chunkTileIndex(x, y)] & 0x0F;
+    }
+    unsigned getBlockLight(unsigned x, unsigned y) const {
+        if (x >= CHUNK_W || y >= CHUNK_H || isFlat()) return 0;
+        return levels_[chunkTileIndex(x, y)] >> 4;
+    }
+    void setBlockLight(unsigned x, unsigned y, unsigned level) {
+        if (x >= CHUNK_W || y >= CHUNK_H) return;
+        if (isFlat()) {
+            if (level == 0) return;
+            materialize();
+        }
+        setBlock(chunkTileIndex(x, y), level);
     }
 
-    // Calculate lighting for entire chunk based on tile data
-    void calculateLighting(const Chunk& chunk, unsigned ambientLight = 0);
+    // Sky exposure entering each column through the top row (open sky by default)
+    unsigned skyAbove(unsigned x) const { return x < CHUNK_W ? skyAbove_[x] : 0; }
+    void setSkyAbove(unsigned x, unsigned level) {
+        if (x < CHUNK_W) skyAbove_[x] = static_cast<std::uint8_t>(std::min(level, MAX_LIGHT_LEVEL));
+    }
+
+    // Calculate lighting for entire chunk based on tile data (both channels).
+    // An all-air chunk goes flat instead.
+    void calculateLighting(const Chunk& chunk);
+    void calculateSkyLighting(const Chunk& chunk);
+    // Sky exposure only depends on the tiles above in the same column
+    void updateSkyColumn(const Chunk& chunk, unsigned x);
+    // Emitters inside this chunk only; neighbours are stitched in by the world.
+    // One multi-source flood over a bucket queue keyed by light level.
+    void calculateBlockLighting(const Chunk& chunk);
 
 private:
-    unsigned w_, h_;
-    std::vector<unsigned> lightLevels_;
+    std::vector<std::uint8_t> levels_;               // CHUNK_TILES bytes, sky | block << 4; empty while flat
+    std::array<std::uint8_t, CHUNK_W> skyAbove_{};   // per column
 
-    // Light propagation using flood-fill algorithm
-    void propagateLight(const Chunk& chunk, unsigned startX, unsigned startY, unsigned lightLevel);
-};
\ No newline at end of file
+    // Flat -> per-tile bytes holding what the flat map reads as
+    void materialize();
+    void skyLighting(const TileID* tiles);
+    void blockLighting(const TileID* tiles);
+
+    void setBlock(size_t i, unsigned level) {
+        levels_[i] = static_cast<std::uint8_t>((levels_[i] & 0x0F) | (std::min(level, MAX_LIGHT_LEVEL) << 4));
+    }
+};
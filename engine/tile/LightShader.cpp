@@ -0,0 +1,72 @@
+#include "engine/tile/LightShader.hpp"
+#include "engine/tile/LightMap.hpp"
+#include <cstdint>
+
+namespace {
+// Vertex colour layout in shader mode: r = block * 17, g = sky * 17,
+// b = 255 for underground stone
+constexpr std::uint8_t FLAG_UNDERGROUND_STONE = 255;
+
+// Mirrors LightMap::combine and LightShader::brightness
+constexpr const char* FRAGMENT_SOURCE = R"(
+uniform sampler2D texture;
+uniform float ambient;
+
+void main() {
+    vec4 raw = floor(gl_Color * 255.0 + 0.5);
+    float block = floor(raw.r / 17.0 + 0.5);
+    float sky   = floor(raw.g / 17.0 + 0.5);
+    bool undergroundStone = raw.b >= 128.0;
+
+    float base = 7.0;
+    if (sky > 0.0) {
+        float a = min(ambient, 15.0);
+        base = max(max(2.0, floor(a / 4.0)), max(0.0, a - (15.0 - sky)));
+    }
+    float level = max(block, base);
+
+    float f;
+    if (undergroundStone)  f = level >= 10.0 ? 0.7 : (level >= 8.0 ? 0.6 : 0.5);
+    else if (level >= 10.0) f = 1.0;
+    else if (level >= 6.0)  f = 0.7 + 0.3 * (level - 6.0) / 4.0;
+    else                    f = 0.2 + 0.5 * level / 6.0;
+
+    gl_FragColor = texture2D(texture, gl_TexCoord[0].xy) * vec4(f, f, f, 1.0);
+}
+)";
+} // namespace
+
+LightShader::LightShader() {
+    if (!sf::Shader::isAvailable()) return;
+    if (!shader_.loadFromMemory(FRAGMENT_SOURCE, sf::Shader::Type::Fragment)) return;
+    shader_.setUniform("texture", sf::Shader::CurrentTexture);
+    active_ = true;
+}
+
+void LightShader::setAmbient(float ambient) {
+    if (active_) shader_.setUniform("ambient", ambient);
+}
+
+sf::Color LightShader::vertexColor(unsigned blockLight, unsigned skyLight, bool undergroundStone,
+                                   unsigned ambient) const {
+    if (active_) {
+        const std::uint8_t flags = undergroundStone ? FLAG_UNDERGROUND_STONE : 0;
+        return sf::Color{static_cast<std::uint8_t>(blockLight * 17), static_cast<std::uint8_t>(skyLight * 17), flags, 255};
+    }
+    const unsigned level = LightMap::combine(blockLight, skyLight, ambient);
+    const std::uint8_t b = static_cast<std::uint8_t>(255 * brightness(level, undergroundStone));
+    return sf::Color{b, b, b, 255};
+}
+
+float LightShader::brightness(unsigned lightLevel, bool undergroundStone) {
+    if (undergroundStone) {
+        // Underground stone: use simplified lighting that reduces variation
+        if (lightLevel >= 10) return 0.7f; // Bright areas (near torches) but not full bright
+        if (lightLevel >= 8)  return 0.6f; // Medium bright
+        return 0.5f;                       // Base underground brightness
+    }
+    // Normal lighting calculation for surface tiles and non-stone
+    if (lightLevel >= 10) return 1.0f;
+    if (lightLevel >= 6)  return 0.7f + 0.3f * (lightLevel - 6) / 4.0f;
+    return 0.2f + 0.5f * lightLevel / 6.0f;
+}
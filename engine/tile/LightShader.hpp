@@ -0,0 +1,34 @@
+#pragma once
+#include <SFML/Graphics.hpp>
+
+// Applies the time of day to chunk meshes at draw time.
+//
+// When shaders are available, meshes carry raw light in their vertex colours
+// (block light, sky exposure and a stone flag) and a fragment shader combines
+// them with the current ambient level, so a day/night cycle is one uniform update:
+// no relight, no remesh. Without shader support the final brightness is baked into
+// the vertices instead and an ambient change costs a remesh (still no relight).
+class LightShader {
+public:
+    LightShader(); // needs a GL context, like any sf::Shader
+
+    LightShader(const LightShader&) = delete;
+    LightShader& operator=(const LightShader&) = delete;
+
+    bool active() const { return active_; }
+    const sf::Shader* shader() const { return active_ ? &shader_ : nullptr; }
+    // Fractional levels blend smoothly between neighbouring ones
+    void setAmbient(float ambient);
+
+    // Vertex colour for a tile; ambient only matters when baking. Const and safe to
+    // call from worker threads.
+    sf::Color vertexColor(unsigned blockLight, unsigned skyLight, bool undergroundStone,
+                          unsigned ambient) const;
+
+    // Light level -> colour multiplier; the shader mirrors this
+    static float brightness(unsigned lightLevel, bool undergroundStone);
+
+private:
+    sf::Shader shader_;
+    bool active_ = false;
+};
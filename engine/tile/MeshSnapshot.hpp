@@ -0,0 +1,40 @@
+#pragma once
+#include <SFML/Graphics.hpp>
+#include <memory>
+#include <vector>
+
+// Read-only copy of one mesh layer, for drawing on another thread while the
+// owner keeps patching the original (see World::publish)
+struct MeshSnapshot {
+    std::vector<sf::Vertex> vertices;     // triangles
+    sf::Vector2f offset{0.f, 0.f};        // world pixels
+    const sf::Texture* texture = nullptr; // null for untextured layers
+    bool lit = false;                     // drawn with the light shader
+
+    void draw(sf::RenderTarget& t, sf::RenderStates s, const sf::Shader* lightShader) const {
+        s.transform.translate(offset);
+        s.texture = texture;
+        s.shader = lit ? lightShader : nullptr;
+        t.draw(vertices.data(), vertices.size(), sf::PrimitiveType::Triangles, s);
+    }
+};
+using MeshHandle = std::shared_ptr<const MeshSnapshot>;
+
+// A batch's current snapshot. The same copy is handed out until the mesh changes,
+// so publishing an unchanged mesh only bumps a reference count.
+class MeshPublisher {
+public:
+    // Call whenever the mesh changes
+    void invalidate() { handle_.reset(); }
+
+    // Appends the layer's snapshot to out; empty layers are skipped
+    void publish(std::vector<MeshHandle>& out, const std::vector<sf::Vertex>& vertices, sf::Vector2f offset,
+                 const sf::Texture* texture, bool lit) {
+        if (vertices.empty()) return;
+        if (!handle_) handle_ = std::make_shared<const MeshSnapshot>(MeshSnapshot{vertices, offset, texture, lit});
+        out.push_back(handle_);
+    }
+
+private:
+    MeshHandle handle_;
+};
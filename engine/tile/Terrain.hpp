@@ -0,0 +1,67 @@
+#pragma once
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include "engine/tile/TileTypes.hpp"
+#include "engine/noise/ValueNoise.hpp"
+
+// Terrain shape shared by chunk generation and anything that needs to know where
+// the ground is without generating the chunk (e.g. the world's skylight heightmap).
+
+// World y of the generated grass surface in column worldX, before trees, caves and edits
+inline int terrainSurfaceY(int worldX, unsigned chunkHeight = CHUNK_H) {
+    const float mid  = chunkHeight * 0.55f;
+    const float amp  = chunkHeight * 0.18f;
+    const float wavL = 180.f; // tiles
+    const float twoPi = 6.28318530718f;
+    const float freq = twoPi / wavL;
+    return static_cast<int>(std::floor(mid + amp * std::sin(freq * static_cast<float>(worldX))));
+}
+
+// Surface of the CHUNK_W columns in chunk column cx
+using SurfaceStrip = std::array<int, CHUNK_W>;
+inline void terrainSurfaceStrip(int cx, SurfaceStrip& out) {
+    const int x0 = cx * static_cast<int>(CHUNK_W);
+    for (unsigned lx = 0; lx < CHUNK_W; ++lx) out[lx] = terrainSurfaceY(x0 + static_cast<int>(lx));
+}
+
+// Cave noise: fbm2 over these per-column / per-row coordinates. Kept separable so
+// generators can evaluate whole blocks with fbm2Grid.
+constexpr std::uint64_t CAVE_SALT = 0xC0FFEE5EEDULL; // valid hex, 64-bit
+inline float caveNoiseX(int worldX) {
+    const float baseFreq = 1.0f / 22.0f; // larger -> more caves
+    return static_cast<float>(worldX) * baseFreq;
+}
+inline float caveNoiseY(int worldY) {
+    const float baseFreq = 1.0f / 22.0f;
+    return static_cast<float>(worldY) * baseFreq * 0.8f;
+}
+inline float caveNoise(int worldX, int worldY, unsigned seed) {
+    return fbm2(caveNoiseX(worldX), caveNoiseY(worldY), static_cast<std::uint64_t>(seed) ^ CAVE_SALT,
+                /*octaves=*/4, /*lacunarity=*/2.0f, /*gain=*/0.5f);
+}
+// Top layers stay solid; cave noise is only looked at from this depth down
+constexpr int CAVE_MIN_DEPTH = 6;
+
+// Generated tile at worldY before trees and edits, given the column's surface and
+// the cave noise at that tile (ignored above CAVE_MIN_DEPTH)
+inline TileID terrainTile(int worldY, int surface, float caveNoise) {
+    if (worldY < surface)      return Tile::Air;
+    if (worldY == surface)     return Tile::Grass;
+    if (worldY <= surface + 4) return Tile::Dirt;
+
+    const int depthBelowSurface = worldY - surface;
+    if (depthBelowSurface < CAVE_MIN_DEPTH) return Tile::Stone;
+    // FBM noise; deeper -> more caverns (lower threshold)
+    // depth factor 0..1 over ~80 tiles
+    const float d = std::clamp(depthBelowSurface / 80.f, 0.f, 1.f);
+    const float threshold = 0.62f - 0.25f * d; // deeper => more carve
+    return caveNoise > threshold ? Tile::Stone : Tile::Air;
+}
+
+// Same for a single tile, evaluating the noise only where it matters
+inline TileID terrainTileAt(int worldX, int worldY, int surface, unsigned seed) {
+    const float n = worldY - surface >= CAVE_MIN_DEPTH ? caveNoise(worldX, worldY, seed) : 0.f;
+    return terrainTile(worldY, surface, n);
+}
@@ -1,16 +1,28 @@
 #include "engine/tile/TileBatch.hpp"
 #include "engine/tile/TileTypes.hpp"
 #include "engine/tile/Coords.hpp"
+#include <algorithm>
+#include <array>
 
-static inline void pushVertex(sf::VertexArray& va, float x, float y, float u, float v, sf::Color color = sf::Color::White) {
-    sf::Vertex vert{};
+static inline void setVertex(sf::Vertex& vert, float x, float y, float u, float v, sf::Color color) {
     vert.position  = {x, y};
     vert.texCoords = {u, v};
     vert.color     = color;
-    va.append(vert);
 }
 
-void TileBatch::addQuad(sf::VertexArray& va, float x, float y, float s, const sf::IntRect& uv, sf::Color color) {
+// For underground stone tiles, use simplified lighting to avoid banding
+static inline sf::Color tileColor(const LightShader& light, unsigned ambient, int worldY, TileID t,
+                                  unsigned block, unsigned sky) {
+    return light.vertexColor(block, sky, t == Tile::Stone && worldY >= 8, ambient);
+}
+static inline sf::Color tileColor(const Chunk& chunk, const LightShader& light, unsigned ambient,
+                                  unsigned x, unsigned y, TileID t) {
+    const LightMap& lightMap = chunk.getLightMap();
+    const int worldY = chunkOriginTiles(chunk.coord()).y + static_cast<int>(y);
+    return tileColor(light, ambient, worldY, t, lightMap.getBlockLight(x, y), lightMap.getSkyLight(x, y));
+}
+
+void TileBatch::writeQuad(sf::Vertex* out, float x, float y, float s, const sf::IntRect& uv, sf::Color color) {
     // Use exact tile boundaries to prevent background bleeding
     const float x0 = x,     y0 = y;
     const float x1 = x + s, y1 = y + s;
@@ -22,18 +34,24 @@ void TileBatch::addQuad(sf::VertexArray& va, float x, float y, float s, const sf
     const float v1 = static_cast<float>(uv.position.y + uv.size.y);
 
     // tri 1
-    pushVertex(va, x0, y0, u0, v0, color);
-    pushVertex(va, x1, y0, u1, v0, color);
-    pushVertex(va, x1, y1, u1, v1, color);
+    setVertex(out[0], x0, y0, u0, v0, color);
+    setVertex(out[1], x1, y0, u1, v0, color);
+    setVertex(out[2], x1, y1, u1, v1, color);
     // tri 2
-    pushVertex(va, x0, y0, u0, v0, color);
-    pushVertex(va, x1, y1, u1, v1, color);
-    pushVertex(va, x0, y1, u0, v1, color);
+    setVertex(out[3], x0, y0, u0, v0, color);
+    setVertex(out[4], x1, y1, u1, v1, color);
+    setVertex(out[5], x0, y1, u0, v1, color);
 }
 
-void TileBatch::build(const Chunk& chunk, const TileAtlas& atlas) {
+void TileBatch::addQuad(std::vector<sf::Vertex>& va, float x, float y, float s, const sf::IntRect& uv, sf::Color color) {
+    va.resize(va.size() + 6);
+    writeQuad(va.data() + va.size() - 6, x, y, s, uv, color);
+}
+
+void TileBatch::build(const Chunk& chunk, const TileAtlas& atlas, const LightShader& light, unsigned ambient) {
     va_.clear();
-    va_.setPrimitiveType(sf::PrimitiveType::Triangles);
+    tileOf_.clear();
+    published_.invalidate();
     tex_ = &atlas.texture();
 
     // chunk origin in pixels
@@ -41,64 +59,111 @@ void TileBatch::build(const Chunk& chunk, const TileAtlas& atlas) {
     pixelOffset_ = {orgTiles.x * static_cast<float>(TILE_SIZE),
                     orgTiles.y * static_cast<float>(TILE_SIZE)};
 
-    const unsigned W = chunk.width();
-    const unsigned H = chunk.height();
-    const float    S = static_cast<float>(atlas.tileSize());
+    // Nothing to draw; without a slot table the first edit rebuilds from scratch
+    if (chunk.isAllAir()) {
+        std::vector<std::uint16_t>().swap(slotOf_);
+        isDirty_ = false;
+        hasDirtyRect_ = false;
+        return;
+    }
+
+    // Tiles unpacked once and light read as raw bytes, so the loops below are plain
+    // array walks (per-thread scratch: chunks are meshed on the workers)
+    thread_local std::array<TileID, CHUNK_TILES> tiles;
+    chunk.copyTiles(tiles.data());
+    const LightMap& lightMap = chunk.getLightMap();
+    const std::uint8_t* levels = lightMap.levels();
+
+    size_t quads = 0;
+    for (const TileID t : tiles) quads += t != Tile::Air;
+    va_.resize(quads * 6);
+    tileOf_.resize(quads);
+    slotOf_.assign(CHUNK_TILES, NO_SLOT);
 
-    for (unsigned y = 0; y < H; ++y) {
-        for (unsigned x = 0; x < W; ++x) {
-            TileID t = chunk.get(x, y);
+    const float S = static_cast<float>(atlas.tileSize());
+    std::uint16_t slot = 0;
+    for (unsigned y = 0; y < CHUNK_H; ++y) {
+        const int worldY = orgTiles.y + static_cast<int>(y);
+        for (unsigned x = 0; x < CHUNK_W; ++x) {
+            const size_t i = chunkTileIndex(x, y);
+            const TileID t = tiles[i];
             if (t == Tile::Air) continue;
-            
-            // Calculate lighting color
-            const LightMap& lightMap = chunk.getLightMap();
-            unsigned lightLevel = lightMap.getLight(x, y);
-            
-            // For underground stone tiles, use simplified lighting to avoid banding
-            const auto orgTiles = chunkOriginTiles(chunk.coord());
-            const int worldY = orgTiles.y + static_cast<int>(y);
-            
-            sf::Color tileColor;
-            if (t == Tile::Stone && worldY >= 8) {
-                // Underground stone: use simplified lighting that reduces variation
-                float lightFactor;
-                if (lightLevel >= 10) {
-                    lightFactor = 0.7f; // Bright areas (near torches) but not full bright
-                } else if (lightLevel >= 8) {
-                    lightFactor = 0.6f; // Medium bright
-                } else {
-                    lightFactor = 0.5f; // Base underground brightness
-                }
-                
-                std::uint8_t brightness = static_cast<std::uint8_t>(255 * lightFactor);
-                tileColor = sf::Color{brightness, brightness, brightness, 255};
-            } else {
-                // Normal lighting calculation for surface tiles and non-stone
-                float lightFactor = static_cast<float>(lightLevel) / static_cast<float>(MAX_LIGHT_LEVEL);
-                
-                if (lightLevel >= 10) {
-                    lightFactor = 1.0f;
-                } else if (lightLevel >= 6) {
-                    lightFactor = 0.7f + 0.3f * (lightLevel - 6) / 4.0f;
-                } else {
-                    lightFactor = 0.2f + 0.5f * lightLevel / 6.0f;
-                }
-                
-                std::uint8_t brightness = static_cast<std::uint8_t>(255 * lightFactor);
-                tileColor = sf::Color{brightness, brightness, brightness, 255};
-            }
-            
-            addQuad(va_, x * S, y * S, S, atlas.uvFor(t), tileColor);
+
+            const unsigned packed = levels ? levels[i] : lightMap.skyAbove(x); // sky | block << 4
+            slotOf_[i] = slot;
+            tileOf_[slot] = static_cast<std::uint16_t>(i);
+            writeQuad(va_.data() + size_t(slot) * 6, x * S, y * S, S, atlas.uvFor(t),
+                      tileColor(light, ambient, worldY, t, packed >> 4, packed & 0x0F));
+            ++slot;
         }
     }
     isDirty_ = false;
+    hasDirtyRect_ = false;
 }
 
-void TileBatch::updateRegion(const Chunk& chunk, const TileAtlas& atlas,
+void TileBatch::patchTile(const Chunk& chunk, const TileAtlas& atlas, const LightShader& light, unsigned ambient,
+                          unsigned x, unsigned y) {
+    const size_t i = chunkTileIndex(x, y);
+    const TileID t = chunk.getUnchecked(x, y);
+    const std::uint16_t slot = slotOf_[i];
+
+    if (t == Tile::Air) {
+        if (slot == NO_SLOT) return;
+        // Move the last quad into the hole so the mesh stays packed
+        const std::uint16_t last = static_cast<std::uint16_t>(tileOf_.size() - 1);
+        if (slot != last) {
+            std::copy_n(va_.begin() + size_t(last) * 6, 6, va_.begin() + size_t(slot) * 6);
+            tileOf_[slot] = tileOf_[last];
+            slotOf_[tileOf_[slot]] = slot;
+        }
+        tileOf_.pop_back();
+        va_.resize(va_.size() - 6);
+        slotOf_[i] = NO_SLOT;
+        return;
+    }
+
+    const float S = static_cast<float>(atlas.tileSize());
+    const sf::Color color = tileColor(chunk, light, ambient, x, y, t);
+    if (slot == NO_SLOT) {
+        slotOf_[i] = static_cast<std::uint16_t>(tileOf_.size());
+        tileOf_.push_back(static_cast<std::uint16_t>(i));
+        addQuad(va_, x * S, y * S, S, atlas.uvFor(t), color);
+    } else {
+        writeQuad(va_.data() + size_t(slot) * 6, x * S, y * S, S, atlas.uvFor(t), color);
+    }
+}
+
+void TileBatch::updateRegion(const Chunk& chunk, const TileAtlas& atlas, const LightShader& light, unsigned ambient,
                            unsigned minX, unsigned minY, unsigned maxX, unsigned maxY) {
-    // For now, fall back to full rebuild for simplicity
-    // TODO: Implement true partial updates with vertex manipulation
+    // No slot table yet: nothing to patch
+    if (slotOf_.size() != CHUNK_TILES) {
+        build(chunk, atlas, light, ambient);
+        return;
+    }
+    maxX = std::min(maxX, CHUNK_W - 1);
+    maxY = std::min(maxY, CHUNK_H - 1);
+    published_.invalidate();
+    for (unsigned y = minY; y <= maxY; ++y) {
+        for (unsigned x = minX; x <= maxX; ++x) patchTile(chunk, atlas, light, ambient, x, y);
+    }
+}
+
+void TileBatch::update(const Chunk& chunk, const TileAtlas& atlas, const LightShader& light, unsigned ambient) {
     if (isDirty_) {
-        build(chunk, atlas);
+        build(chunk, atlas, light, ambient);
+    } else if (hasDirtyRect_) {
+        hasDirtyRect_ = false;
+        updateRegion(chunk, atlas, light, ambient, dirtyMinX_, dirtyMinY_, dirtyMaxX_, dirtyMaxY_);
+    }
+}
+
+void TileBatch::markDirty(unsigned minX, unsigned minY, unsigned maxX, unsigned maxY) {
+    if (!hasDirtyRect_) {
+        dirtyMinX_ = minX; dirtyMinY_ = minY;
+        dirtyMaxX_ = maxX; dirtyMaxY_ = maxY;
+        hasDirtyRect_ = true;
+        return;
     }
+    dirtyMinX_ = std::min(dirtyMinX_, minX); dirtyMinY_ = std::min(dirtyMinY_, minY);
+    dirtyMaxX_ = std::max(dirtyMaxX_, maxX); dirtyMaxY_ = std::max(dirtyMaxY_, maxY);
 }
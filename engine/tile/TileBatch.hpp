@@ -1,31 +1,75 @@
 #pragma once
 #include <SFML/Graphics.hpp>
+#include <cstdint>
+#include <vector>
 #include "engine/tile/Chunk.hpp"
 #include "engine/tile/TileAtlas.hpp"
+#include "engine/tile/LightShader.hpp"
+#include "engine/tile/MeshSnapshot.hpp"
 
+// Chunk mesh: one quad per non-air tile.
+//
+// Every tile owns a stable quad slot in va_ (slotOf_), so an edited rectangle is
+// patched in place: colours and UVs are rewritten, new tiles append a quad and
+// tiles turned to air swap the last quad into their hole. Remeshing costs
+// O(tiles in the rectangle), not O(chunk).
 class TileBatch : public sf::Drawable {
 public:
-    void build(const Chunk& chunk, const TileAtlas& atlas);
-    void updateRegion(const Chunk& chunk, const TileAtlas& atlas, 
+    // ambient: time of day to bake in when the light shader is unavailable
+    void build(const Chunk& chunk, const TileAtlas& atlas, const LightShader& light, unsigned ambient);
+    // Re-emit tiles in [minX, maxX] x [minY, maxY] (chunk-local, inclusive)
+    void updateRegion(const Chunk& chunk, const TileAtlas& atlas, const LightShader& light, unsigned ambient,
                      unsigned minX, unsigned minY, unsigned maxX, unsigned maxY);
+    // Bring the mesh up to date: a full build or just the dirty rectangle
+    void update(const Chunk& chunk, const TileAtlas& atlas, const LightShader& light, unsigned ambient);
     
-    bool isDirty() const { return isDirty_; }
+    size_t memoryBytes() const {
+        return va_.capacity() * sizeof(sf::Vertex) + (slotOf_.capacity() + tileOf_.capacity()) * sizeof(std::uint16_t);
+    }
+    size_t capacity() const { return va_.capacity(); }
+    size_t vertexCount() const { return va_.size(); }
+
+    // Drop the mesh but keep the vertex buffer for reuse
+    void clear() {
+        va_.clear(); slotOf_.clear(); tileOf_.clear(); isDirty_ = false; hasDirtyRect_ = false;
+        published_.invalidate();
+    }
+
+    // Append a read-only copy of the mesh (lit), made once per change
+    void publish(std::vector<MeshHandle>& out) { published_.publish(out, va_, pixelOffset_, tex_, /*lit=*/true); }
+    void dropSnapshot() { published_.invalidate(); }
+
+    bool isDirty() const { return isDirty_ || hasDirtyRect_; }
     void markDirty() { isDirty_ = true; }
-    void markClean() { isDirty_ = false; }
+    // Only these tiles changed (chunk-local, inclusive); rectangles accumulate
+    void markDirty(unsigned minX, unsigned minY, unsigned maxX, unsigned maxY);
+    void markClean() { isDirty_ = false; hasDirtyRect_ = false; }
 
 private:
-    sf::VertexArray     va_{sf::PrimitiveType::Triangles};
+    static constexpr std::uint16_t NO_SLOT = 0xFFFF;
+    static_assert(CHUNK_W * CHUNK_H < NO_SLOT, "quad slots are 16-bit");
+
+    std::vector<sf::Vertex> va_;                  // triangles; a plain vector so capacity survives reuse
+    std::vector<std::uint16_t> slotOf_;           // tile index -> quad slot, NO_SLOT for air
+    std::vector<std::uint16_t> tileOf_;           // quad slot -> tile index
     sf::Vector2f        pixelOffset_{0.f, 0.f};   // <- REQUIRED
     const sf::Texture*  tex_ = nullptr;           // <- REQUIRED
-    bool                isDirty_ = false;
+    bool                isDirty_ = false;         // needs a full build
+    bool                hasDirtyRect_ = false;
+    unsigned            dirtyMinX_ = 0, dirtyMinY_ = 0, dirtyMaxX_ = 0, dirtyMaxY_ = 0;
+    MeshPublisher       published_;
+
+    void patchTile(const Chunk& chunk, const TileAtlas& atlas, const LightShader& light, unsigned ambient,
+                   unsigned x, unsigned y);
 
-    static void addQuad(sf::VertexArray& va,
+    static void addQuad(std::vector<sf::Vertex>& va,
                         float x, float y, float s,
                         const sf::IntRect& uv, sf::Color color = sf::Color::White);
+    static void writeQuad(sf::Vertex* out, float x, float y, float s, const sf::IntRect& uv, sf::Color color);
 
     void draw(sf::RenderTarget& t, sf::RenderStates s) const override {
         s.transform.translate(pixelOffset_);
         s.texture = tex_;
-        t.draw(va_, s);
+        if (!va_.empty()) t.draw(va_.data(), va_.size(), sf::PrimitiveType::Triangles, s);
     }
 };
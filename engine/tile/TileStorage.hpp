@@ -0,0 +1,203 @@
+#pragma once
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <type_traits>
+#include <vector>
+#include "engine/tile/TileTypes.hpp"
+
+// Tile IDs of one chunk, stored as compactly as its contents allow:
+//   uniform - one value for every tile, no per-tile storage (sky, solid rock)
+//   palette - 1, 2, 4 or 8-bit indices into a small list of the IDs in use
+//   direct  - raw 16-bit IDs, once more than 256 distinct IDs show up
+// set() widens the representation when a new ID doesn't fit; nothing narrows it
+// again except assign(), which picks the smallest representation for its input.
+// Indices are packed into 64-bit words and never straddle two of them.
+class TileStorage {
+public:
+    explicit TileStorage(size_t count, TileID fill = Tile::Air) : count_(count), palette_{fill} {}
+
+    size_t   size()         const { return count_; }
+    bool     isUniform()    const { return bits_ == 0; }
+    TileID   uniformValue() const { return palette_[0]; } // only meaningful when isUniform()
+    unsigned bitsPerTile()  const { return bits_; }
+    size_t   memoryBytes()  const {
+        return words_.capacity() * sizeof(std::uint64_t) + palette_.capacity() * sizeof(TileID);
+    }
+
+    TileID get(size_t i) const {
+        if (bits_ == 0) return palette_[0];
+        const unsigned v = index(i);
+        return bits_ == DIRECT_BITS ? static_cast<TileID>(v) : palette_[v];
+    }
+
+    void set(size_t i, TileID id) {
+        if (get(i) == id) return;
+        if (bits_ == DIRECT_BITS) {
+            setIndex(i, id);
+            return;
+        }
+        auto it = std::find(palette_.begin(), palette_.end(), id);
+        if (it == palette_.end()) {
+            if (palette_.size() == (size_t(1) << bits_)) widen(); // full: one more bit width
+            if (bits_ == DIRECT_BITS) {
+                setIndex(i, id);
+                return;
+            }
+            palette_.push_back(id);
+            it = palette_.end() - 1;
+        }
+        setIndex(i, static_cast<unsigned>(it - palette_.begin()));
+    }
+
+    // Every tile becomes id; frees the per-tile storage
+    void fill(TileID id) {
+        bits_ = 0;
+        palette_.assign(1, id);
+        std::vector<std::uint64_t>().swap(words_);
+    }
+
+    // Replace all tiles with src (size() entries, row-major) in the smallest representation
+    void assign(const TileID* src) {
+        // Palette in order of appearance (257 entries at most: then it's direct).
+        // IDs below 256 find their index through a table, the rest by searching.
+        std::array<std::uint16_t, 256> small;
+        small.fill(NOT_IN_PALETTE);
+        bool large = false;
+        palette_.clear();
+        for (size_t i = 0; i < count_ && palette_.size() <= 256; ++i) {
+            const TileID id = src[i];
+            if (id < small.size()) {
+                if (small[id] != NOT_IN_PALETTE) continue;
+                small[id] = static_cast<std::uint16_t>(palette_.size());
+            } else {
+                if (std::find(palette_.begin(), palette_.end(), id) != palette_.end()) continue;
+                large = true;
+            }
+            palette_.push_back(id);
+        }
+        if (palette_.size() == 1) {
+            fill(src[0]);
+            return;
+        }
+
+        unsigned bits = 1;
+        while ((size_t(1) << bits) < palette_.size() && bits < DIRECT_BITS) bits *= 2;
+        words_.resize(wordCount(bits));
+        bits_ = bits;
+        if (bits_ == DIRECT_BITS) {
+            palette_.clear();
+            pack<DIRECT_BITS>([&](size_t i) { return src[i]; });
+        } else if (large) {
+            forWidth([&](auto width) {
+                pack<width()>([&](size_t i) {
+                    return static_cast<unsigned>(std::find(palette_.begin(), palette_.end(), src[i]) - palette_.begin());
+                });
+            });
+        } else {
+            forWidth([&](auto width) { pack<width()>([&](size_t i) { return small[src[i]]; }); });
+        }
+    }
+
+    // Decode every tile into out (size() entries, row-major)
+    void copyTo(TileID* out) const {
+        if (bits_ == 0) {
+            std::fill(out, out + count_, palette_[0]);
+            return;
+        }
+        forWidth([&](auto width) { unpack<width()>(out); });
+    }
+
+private:
+    static constexpr unsigned DIRECT_BITS = 16;
+    static constexpr std::uint16_t NOT_IN_PALETTE = 0xFFFF;
+
+    size_t count_;
+    unsigned bits_ = 0;                // 0 = uniform
+    std::vector<TileID> palette_;      // index -> ID; unused in direct mode
+    std::vector<std::uint64_t> words_; // packed indices, 64 / bits_ per word
+
+    size_t wordCount(unsigned bits) const { return (count_ + 64 / bits - 1) / (64 / bits); }
+    std::uint64_t entryMask() const { return (std::uint64_t(1) << bits_) - 1; }
+
+    // Calls f(std::integral_constant<unsigned, bits_>), so the bulk loops below see
+    // the width as a constant and unroll over a word
+    template <typename F>
+    void forWidth(F&& f) const {
+        switch (bits_) {
+            case 1:  f(std::integral_constant<unsigned, 1>{}); break;
+            case 2:  f(std::integral_constant<unsigned, 2>{}); break;
+            case 4:  f(std::integral_constant<unsigned, 4>{}); break;
+            case 8:  f(std::integral_constant<unsigned, 8>{}); break;
+            default: f(std::integral_constant<unsigned, DIRECT_BITS>{}); break;
+        }
+    }
+
+    // words_ = the indices indexOf(i) returns, BITS each
+    template <unsigned BITS, typename IndexOf>
+    void pack(IndexOf&& indexOf) {
+        constexpr unsigned perWord = 64 / BITS;
+        size_t i = 0;
+        for (std::uint64_t& word : words_) {
+            std::uint64_t w = 0;
+            if (i + perWord <= count_) {
+                for (unsigned k = 0; k < perWord; ++k) w |= std::uint64_t(indexOf(i + k)) << (k * BITS);
+                i += perWord;
+            } else {
+                for (unsigned k = 0; i < count_; ++k, ++i) w |= std::uint64_t(indexOf(i)) << (k * BITS);
+            }
+            word = w;
+        }
+    }
+
+    template <unsigned BITS>
+    void unpack(TileID* out) const {
+        constexpr unsigned perWord = 64 / BITS;
+        constexpr std::uint64_t mask = (std::uint64_t(1) << BITS) - 1;
+        auto decode = [&](std::uint64_t v) {
+            return BITS == DIRECT_BITS ? static_cast<TileID>(v) : palette_[static_cast<size_t>(v)];
+        };
+        size_t i = 0;
+        for (const std::uint64_t word : words_) {
+            if (i + perWord <= count_) {
+                for (unsigned k = 0; k < perWord; ++k) out[i + k] = decode((word >> (k * BITS)) & mask);
+                i += perWord;
+            } else {
+                for (unsigned k = 0; i < count_; ++k, ++i) out[i] = decode((word >> (k * BITS)) & mask);
+            }
+        }
+    }
+
+    // bits_ divides 64, so an entry's bit offset picks its word and shift directly
+    unsigned index(size_t i) const {
+        const size_t bit = i * bits_;
+        return static_cast<unsigned>((words_[bit >> 6] >> (bit & 63)) & entryMask());
+    }
+    void setIndex(size_t i, unsigned v) {
+        const size_t bit = i * bits_;
+        std::uint64_t& w = words_[bit >> 6];
+        w = (w & ~(entryMask() << (bit & 63))) | (std::uint64_t(v) << (bit & 63));
+    }
+
+    // Re-pack at twice the width; past 8 bits the palette is dropped for raw IDs
+    void widen() {
+        const unsigned newBits = bits_ == 0 ? 1 : bits_ * 2;
+        std::vector<std::uint64_t> old;
+        old.swap(words_);
+        const unsigned oldBits = bits_;
+        words_.assign(wordCount(newBits), 0);
+        bits_ = newBits;
+        if (oldBits == 0) {
+            if (bits_ == DIRECT_BITS) for (size_t i = 0; i < count_; ++i) setIndex(i, palette_[0]);
+            return; // otherwise every tile is index 0 already
+        }
+
+        const std::uint64_t oldMask = (std::uint64_t(1) << oldBits) - 1;
+        for (size_t i = 0; i < count_; ++i) {
+            const size_t bit = i * oldBits;
+            const unsigned v = static_cast<unsigned>((old[bit >> 6] >> (bit & 63)) & oldMask);
+            setIndex(i, bits_ == DIRECT_BITS ? palette_[v] : v);
+        }
+        if (bits_ == DIRECT_BITS) palette_.clear();
+    }
+};
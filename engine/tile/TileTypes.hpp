@@ -1,4 +1,5 @@
 #pragma once
+#include <cstddef>
 #include <cstdint>
 
 using TileID = std::uint16_t;
@@ -20,9 +21,21 @@ inline unsigned getLightEmission(TileID id) {
     }
 }
 inline bool blocksLight(TileID id) {
-    return id != Tile::Air && id != Tile::Leaves; // leaves partially block light
+    // leaves partially block light; emitters shine out of their own tile
+    return id != Tile::Air && id != Tile::Leaves && !isLightSource(id);
+}
+// Light level a tile holding `level` passes on to each neighbour
+inline unsigned transmitLight(TileID id, unsigned level) {
+    if (level <= 1) return 0;
+    if (id == Tile::Leaves) return level - 2; // leaves reduce light more
+    if (blocksLight(id)) return 0;            // light reaches solid tiles but doesn't pass through
+    return level - 1;
 }
 
 inline constexpr unsigned TILE_SIZE = 16; // px
 inline constexpr unsigned CHUNK_W   = 128;
 inline constexpr unsigned CHUNK_H   = 64;
+inline constexpr size_t   CHUNK_TILES = size_t(CHUNK_W) * CHUNK_H;
+
+// Row-major index of a chunk-local tile; every per-tile array in a chunk uses it
+constexpr size_t chunkTileIndex(unsigned x, unsigned y) { return size_t(y) * CHUNK_W + x; }
@@ -0,0 +1,143 @@
+#pragma once
+#include <cstdint>
+#include <utility>
+#include <vector>
+#include "engine/tile/Coords.hpp"
+
+// Flat open-addressing map from ChunkCoord to V.
+//
+// Slots live in one contiguous array and are addressed by the Morton code of the
+// coordinate, so chunks that are close in the world are close in memory: a
+// visible rectangle maps onto a few short runs of slots. Linear probing with
+// backward-shift deletion (no tombstones); lookups and erases never allocate,
+// inserts only when the table grows past a load factor of 1/2.
+template <typename V>
+class ChunkTable {
+public:
+    explicit ChunkTable(size_t initialCapacity = 64) { rehash(initialCapacity); }
+
+    size_t size()     const { return size_; }
+    bool   empty()    const { return size_ == 0; }
+    size_t capacity() const { return slots_.size(); }
+
+    V* find(ChunkCoord c) {
+        for (size_t i = home(c);; i = (i + 1) & mask_) {
+            Slot& s = slots_[i];
+            if (!s.used) return nullptr;
+            if (s.key == c) return &s.value;
+        }
+    }
+    const V* find(ChunkCoord c) const { return const_cast<ChunkTable*>(this)->find(c); }
+    bool contains(ChunkCoord c) const { return find(c) != nullptr; }
+
+    // Insert or overwrite
+    V& insert(ChunkCoord c, V value) {
+        if ((size_ + 1) * 2 > slots_.size()) rehash(slots_.size() * 2);
+        for (size_t i = home(c);; i = (i + 1) & mask_) {
+            Slot& s = slots_[i];
+            if (s.used && !(s.key == c)) continue;
+            if (!s.used) {
+                s.used = true;
+                s.key = c;
+                ++size_;
+            }
+            s.value = std::move(value);
+            return s.value;
+        }
+    }
+
+    // Remove and return the value (default V if absent)
+    V take(ChunkCoord c) {
+        size_t i = home(c);
+        for (;; i = (i + 1) & mask_) {
+            if (!slots_[i].used) return V{};
+            if (slots_[i].key == c) break;
+        }
+        V out = std::move(slots_[i].value);
+
+        // Backward shift: pull later members of the probe run into the hole
+        size_t hole = i;
+        for (size_t j = (i + 1) & mask_; slots_[j].used; j = (j + 1) & mask_) {
+            const size_t h = home(slots_[j].key);
+            // Move j into the hole unless its home lies cyclically in (hole, j]
+            const bool stays = (hole <= j) ? (hole < h && h <= j) : (hole < h || h <= j);
+            if (stays) continue;
+            slots_[hole].key = slots_[j].key;
+            slots_[hole].value = std::move(slots_[j].value);
+            hole = j;
+        }
+        slots_[hole].used = false;
+        slots_[hole].value = V{};
+        --size_;
+        return out;
+    }
+    bool erase(ChunkCoord c) {
+        if (!contains(c)) return false;
+        take(c);
+        return true;
+    }
+
+    // Visit every element in slot order; f(ChunkCoord, V&). Must not insert or erase.
+    template <typename F>
+    void forEach(F&& f) {
+        for (Slot& s : slots_) if (s.used) f(s.key, s.value);
+    }
+    template <typename F>
+    void forEach(F&& f) const {
+        for (const Slot& s : slots_) if (s.used) f(s.key, s.value);
+    }
+
+    void reserve(size_t n) {
+        if (n * 2 > slots_.size()) rehash(n * 2);
+    }
+
+    void clear() {
+        for (Slot& s : slots_) {
+            s.used = false;
+            s.value = V{};
+        }
+        size_ = 0;
+    }
+
+    // Interleave the low 32 bits of x and y (x in even bits)
+    static std::uint64_t morton(ChunkCoord c) {
+        return spread(static_cast<std::uint32_t>(c.x)) | (spread(static_cast<std::uint32_t>(c.y)) << 1);
+    }
+
+private:
+    struct Slot {
+        ChunkCoord key{};
+        bool used = false;
+        V value{};
+    };
+
+    static std::uint64_t spread(std::uint32_t v) {
+        std::uint64_t x = v;
+        x = (x | (x << 16)) & 0x0000FFFF0000FFFFull;
+        x = (x | (x << 8))  & 0x00FF00FF00FF00FFull;
+        x = (x | (x << 4))  & 0x0F0F0F0F0F0F0F0Full;
+        x = (x | (x << 2))  & 0x3333333333333333ull;
+        x = (x | (x << 1))  & 0x5555555555555555ull;
+        return x;
+    }
+
+    size_t home(ChunkCoord c) const { return static_cast<size_t>(morton(c)) & mask_; }
+
+    void rehash(size_t newCapacity) {
+        size_t cap = 16;
+        while (cap < newCapacity) cap *= 2;
+
+        std::vector<Slot> old = std::move(slots_);
+        slots_.clear();
+        slots_.resize(cap);
+        mask_ = cap - 1;
+        size_ = 0;
+        for (Slot& s : old) {
+            if (s.used) insert(s.key, std::move(s.value));
+        }
+    }
+
+    std::vector<Slot> slots_;
+    size_t mask_ = 0;
+    size_t size_ = 0;
+};
@@ -0,0 +1,225 @@
+#include "engine/world/LightEngine.hpp"
+#include "engine/tile/Chunk.hpp"
+#include <algorithm>
+
+namespace {
+constexpr int DX[4] = {-1, 1, 0, 0};
+constexpr int DY[4] = {0, 0, -1, 1};
+} // namespace
+
+LightEngine::Cell LightEngine::cellAt(int tx, int ty) {
+    const ChunkCoord cc = tileToChunk(tx, ty);
+    if (!cacheValid_ || !(cachedCoord_ == cc)) {
+        cachedCoord_ = cc;
+        cachedChunk_ = lookup_(ctx_, cc);
+        cacheValid_ = true;
+    }
+    Cell c;
+    c.chunk = cachedChunk_;
+    c.lx = static_cast<unsigned>(tx - cc.x * static_cast<int>(CHUNK_W));
+    c.ly = static_cast<unsigned>(ty - cc.y * static_cast<int>(CHUNK_H));
+    return c;
+}
+
+unsigned LightEngine::blockLight(const Cell& c) const {
+    return c.chunk->getLightMap().getBlockLight(c.lx, c.ly);
+}
+
+void LightEngine::setBlockLight(const Cell& c, unsigned level) {
+    c.chunk->getLightMap().setBlockLight(c.lx, c.ly, level);
+    noteChanged(c.chunk->coord(), c.lx, c.ly, c.lx, c.ly);
+}
+
+void LightEngine::noteChanged(ChunkCoord cc, unsigned minX, unsigned minY, unsigned maxX, unsigned maxY) {
+    if (lastChanged_ >= changed_.size() || !(changed_[lastChanged_].coord == cc)) {
+        auto it = std::find_if(changed_.begin(), changed_.end(), [&](const ChangedChunk& c) { return c.coord == cc; });
+        if (it == changed_.end()) {
+            changed_.push_back({cc, minX, minY, maxX, maxY});
+            lastChanged_ = changed_.size() - 1;
+            return;
+        }
+        lastChanged_ = static_cast<size_t>(it - changed_.begin());
+    }
+    ChangedChunk& c = changed_[lastChanged_];
+    c.minX = std::min(c.minX, minX); c.minY = std::min(c.minY, minY);
+    c.maxX = std::max(c.maxX, maxX); c.maxY = std::max(c.maxY, maxY);
+}
+
+void LightEngine::skyAbove(ChunkCoord cc, std::uint8_t* out) {
+    const int x0 = cc.x * static_cast<int>(CHUNK_W);
+    const int y0 = cc.y * static_cast<int>(CHUNK_H);
+    for (unsigned lx = 0; lx < CHUNK_W; ++lx) {
+        // Open sky unless something opaque sits above the chunk
+        out[lx] = heights_.top(x0 + static_cast<int>(lx)) < y0 ? 0 : static_cast<std::uint8_t>(MAX_LIGHT_LEVEL);
+    }
+}
+
+int LightEngine::firstOpaqueFrom(int tx, int ty) {
+    for (;; ++ty) {
+        const Cell c = cellAt(tx, ty);
+        if (!c.chunk) return ty; // unknown below here: assume it's solid until that chunk loads
+        if (blocksLight(c.chunk->getUnchecked(c.lx, c.ly))) return ty;
+    }
+}
+
+void LightEngine::setColumnTop(int tx, int newTop) {
+    const int oldTop = heights_.top(tx);
+    if (newTop == oldTop) return;
+    heights_.setTop(tx, newTop);
+
+    // Chunks whose top row lies in (lo, hi] just gained or lost the sky above them
+    const int lo = std::min(oldTop, newTop), hi = std::max(oldTop, newTop);
+    for (ChunkCoord cc = tileToChunk(tx, lo + 1); cc.y * static_cast<int>(CHUNK_H) <= hi; ++cc.y) {
+        const int y0 = cc.y * static_cast<int>(CHUNK_H);
+        if (y0 <= lo) continue;
+        Chunk* chunk = lookup_(ctx_, cc);
+        if (!chunk) continue;
+        const unsigned lx = static_cast<unsigned>(tx - cc.x * static_cast<int>(CHUNK_W));
+        const unsigned seed = newTop < y0 ? 0 : MAX_LIGHT_LEVEL;
+        LightMap& light = chunk->getLightMap();
+        if (light.skyAbove(lx) == seed) continue;
+        light.setSkyAbove(lx, seed);
+        light.updateSkyColumn(*chunk, lx);
+        noteChanged(cc, lx, 0, lx, CHUNK_H - 1);
+    }
+}
+
+void LightEngine::syncSkyAbove(Chunk& chunk) {
+    const ChunkCoord cc = chunk.coord();
+    std::uint8_t seeds[CHUNK_W];
+    skyAbove(cc, seeds);
+    LightMap& light = chunk.getLightMap();
+    for (unsigned lx = 0; lx < CHUNK_W; ++lx) {
+        if (light.skyAbove(lx) == seeds[lx]) continue;
+        light.setSkyAbove(lx, seeds[lx]);
+        light.updateSkyColumn(chunk, lx);
+        noteChanged(cc, lx, 0, lx, CHUNK_H - 1);
+    }
+}
+
+void LightEngine::tileChanged(int tx, int ty) {
+    cacheValid_ = false; // residency may have changed since the last call
+    const Cell c = cellAt(tx, ty);
+    if (!c.chunk) return;
+
+    // Sky: move the column top if this tile was or now is it, then redo the column
+    // below the edit. Tiles under the top see no sky, so edits there change nothing.
+    const bool opaque = blocksLight(c.chunk->getUnchecked(c.lx, c.ly));
+    const int oldTop = heights_.top(tx);
+    if (opaque && ty < oldTop)        setColumnTop(tx, ty);
+    else if (!opaque && ty == oldTop) setColumnTop(tx, firstOpaqueFrom(tx, ty + 1));
+    if (ty <= std::max(oldTop, heights_.top(tx))) {
+        c.chunk->getLightMap().updateSkyColumn(*c.chunk, c.lx);
+        noteChanged(c.chunk->coord(), c.lx, c.ly, c.lx, CHUNK_H - 1); // rows above the edit keep their sky
+    }
+
+    // Whatever lit through this tile before has to be taken back...
+    const unsigned old = blockLight(c);
+    if (old > 0) {
+        setBlockLight(c, 0);
+        removals_.push_back({tx, ty, old, true});
+    }
+    // ...then re-spread from the tile itself (if it emits) and from its neighbours,
+    // whose light may now pass through where it used to be blocked
+    additions_.push_back({tx, ty});
+    for (int d = 0; d < 4; ++d) additions_.push_back({tx + DX[d], ty + DY[d]});
+}
+
+void LightEngine::chunkLoaded(ChunkCoord cc) {
+    cacheValid_ = false;
+    const int x0 = cc.x * static_cast<int>(CHUNK_W), x1 = x0 + static_cast<int>(CHUNK_W) - 1;
+    const int y0 = cc.y * static_cast<int>(CHUNK_H), y1 = y0 + static_cast<int>(CHUNK_H) - 1;
+
+    Chunk* chunk = lookup_(ctx_, cc);
+    if (!chunk) return;
+
+    // The chunk is authoritative for its own rows, unless something opaque is
+    // already known above it
+    for (unsigned lx = 0; lx < CHUNK_W; ++lx) {
+        const int tx = x0 + static_cast<int>(lx);
+        const int oldTop = heights_.top(tx);
+        if (oldTop < y0) continue;
+
+        unsigned ly = 0;
+        while (ly < CHUNK_H && !blocksLight(chunk->getUnchecked(lx, ly))) ++ly;
+        if (ly < CHUNK_H)      setColumnTop(tx, y0 + static_cast<int>(ly));
+        else if (oldTop <= y1) setColumnTop(tx, firstOpaqueFrom(tx, y1 + 1));
+    }
+    syncSkyAbove(*chunk); // lit off-thread; the heightmap may have moved since
+
+    // Queue both sides of every shared edge; the addition flood carries light across
+    auto queueLit = [&](int tx, int ty) {
+        const Cell c = cellAt(tx, ty);
+        if (c.chunk && blockLight(c) > 1) additions_.push_back({tx, ty});
+    };
+    for (int tx = x0; tx <= x1; ++tx) {
+        queueLit(tx, y0); queueLit(tx, y0 - 1);
+        queueLit(tx, y1); queueLit(tx, y1 + 1);
+    }
+    for (int ty = y0; ty <= y1; ++ty) {
+        queueLit(x0, ty); queueLit(x0 - 1, ty);
+        queueLit(x1, ty); queueLit(x1 + 1, ty);
+    }
+}
+
+size_t LightEngine::flush() {
+    cacheValid_ = false;
+    size_t visited = 0;
+
+    // Removal: a tile can only have been lit through a neighbour that was brighter,
+    // so darken dimmer neighbours and hand brighter ones to the addition pass
+    for (size_t head = 0; head < removals_.size(); ++head) {
+        const Removal r = removals_[head];
+        ++visited;
+
+        // Solid tiles receive light but pass none on, so nothing depended on them;
+        // their lit neighbours may still relight them from another side
+        const Cell self = cellAt(r.tx, r.ty);
+        const bool opaque = !r.seed && self.chunk && blocksLight(self.chunk->getUnchecked(self.lx, self.ly));
+
+        for (int d = 0; d < 4; ++d) {
+            const int nx = r.tx + DX[d], ny = r.ty + DY[d];
+            const Cell n = cellAt(nx, ny);
+            if (!n.chunk) continue;
+            const unsigned level = blockLight(n);
+            if (level == 0) continue;
+
+            if (opaque || level >= r.level) {
+                additions_.push_back({nx, ny});
+                continue;
+            }
+            setBlockLight(n, 0);
+            removals_.push_back({nx, ny, level, false});
+            if (isLightSource(n.chunk->getUnchecked(n.lx, n.ly))) additions_.push_back({nx, ny});
+        }
+    }
+    removals_.clear();
+
+    // Addition: breadth-first relaxation; a tile is requeued only when it gets brighter
+    for (size_t head = 0; head < additions_.size(); ++head) {
+        const Addition a = additions_[head];
+        ++visited;
+
+        const Cell self = cellAt(a.tx, a.ty);
+        if (!self.chunk) continue;
+        const TileID tile = self.chunk->getUnchecked(self.lx, self.ly);
+        unsigned level = blockLight(self);
+        const unsigned emission = getLightEmission(tile);
+        if (level < emission) {
+            level = emission;
+            setBlockLight(self, level);
+        }
+
+        const unsigned next = transmitLight(tile, level);
+        if (next == 0) continue;
+        for (int d = 0; d < 4; ++d) {
+            const int nx = a.tx + DX[d], ny = a.ty + DY[d];
+            const Cell n = cellAt(nx, ny);
+            if (!n.chunk || blockLight(n) >= next) continue;
+            setBlockLight(n, next);
+            additions_.push_back({nx, ny});
+        }
+    }
+    additions_.clear();
+    return visited;
+}
@@ -0,0 +1,94 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "engine/tile/Coords.hpp"
+#include "engine/tile/TileTypes.hpp"
+#include "engine/world/SkyHeightmap.hpp"
+
+class Chunk; // forward declaration
+
+// Incremental light propagation in world tile coordinates.
+//
+// Sky: a world heightmap (highest opaque tile per column) decides whether sky
+// enters each chunk column from above. It is updated in O(column) when a tile
+// changes or a chunk loads, and only the resident chunks a moved column top
+// actually crosses get that one column re-seeded.
+//
+// Block: each chunk lights its own emitters when it is built; this engine carries that
+// light across chunk borders and keeps it current under edits without relighting
+// whole chunks. Changes are queued, then flush() runs one removal flood (darken
+// every tile whose light may have come through a changed tile) followed by one
+// addition flood (re-spread from the emitters and lit tiles the removal ran into),
+// so the work is proportional to the area whose light actually changes.
+// Only resident chunks take part; a missing neighbour behaves like an unlit wall.
+class LightEngine {
+public:
+    // Resident chunk at cc, or null
+    using ChunkLookup = Chunk* (*)(void* ctx, ChunkCoord cc);
+
+    LightEngine(ChunkLookup lookup, void* ctx) : lookup_(lookup), ctx_(ctx) {}
+
+    // Sky exposure entering chunk cc through its top row, CHUNK_W entries
+    void skyAbove(ChunkCoord cc, std::uint8_t* out);
+
+    // Tile (tx, ty) has already been rewritten in its chunk. Sky is updated right
+    // away; block light is queued for flush().
+    void tileChanged(int tx, int ty);
+    // Chunk cc just became resident: fold its columns into the heightmap, re-seed its
+    // sky if the heightmap moved since it was lit, and queue the block-light exchange
+    // with its resident neighbours
+    void chunkLoaded(ChunkCoord cc);
+    // Run queued block-light updates; returns the number of tiles visited
+    size_t flush();
+
+    int columnTop(int tx) { return heights_.top(tx); }
+
+    // A chunk whose light changed since the last clear, with the chunk-local
+    // rectangle (inclusive) that covers every changed tile, for remeshing
+    struct ChangedChunk {
+        ChunkCoord coord;
+        unsigned minX, minY, maxX, maxY;
+    };
+    const std::vector<ChangedChunk>& changedChunks() const { return changed_; }
+    void clearChangedChunks() { changed_.clear(); }
+
+private:
+    struct Removal {
+        int tx, ty;
+        unsigned level; // light the tile held before it was darkened
+        bool seed;      // the edited tile itself: its old tile type is unknown
+    };
+    struct Addition {
+        int tx, ty;
+    };
+    // A tile resolved to its chunk
+    struct Cell {
+        Chunk* chunk = nullptr;
+        unsigned lx = 0, ly = 0;
+    };
+
+    Cell cellAt(int tx, int ty);
+    unsigned blockLight(const Cell& c) const;
+    void setBlockLight(const Cell& c, unsigned level);
+    void noteChanged(ChunkCoord cc, unsigned minX, unsigned minY, unsigned maxX, unsigned maxY);
+
+    int firstOpaqueFrom(int tx, int ty); // scans down through resident chunks
+    void setColumnTop(int tx, int newTop);
+    void syncSkyAbove(Chunk& chunk);
+
+    ChunkLookup lookup_;
+    void* ctx_;
+    SkyHeightmap heights_;
+
+    // One-entry lookup cache; floods stay inside one chunk most of the time
+    ChunkCoord cachedCoord_{};
+    Chunk* cachedChunk_ = nullptr;
+    bool cacheValid_ = false;
+
+    // Reused between flushes so steady-state edits don't allocate
+    std::vector<Removal> removals_;
+    std::vector<Addition> additions_;
+    std::vector<ChangedChunk> changed_;
+    size_t lastChanged_ = 0; // floods hit the same chunk many times in a row
+};
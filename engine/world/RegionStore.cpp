@@ -0,0 +1,259 @@
+#include "engine/world/RegionStore.hpp"
+#include "engine/tile/Chunk.hpp"
+#include <array>
+#include <bit>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <vector>
+
+#if defined(_WIN32)
+#  ifndef NOMINMAX
+#    define NOMINMAX
+#  endif
+#  include <windows.h>
+#else
+#  include <fcntl.h>
+#  include <sys/mman.h>
+#  include <sys/stat.h>
+#  include <unistd.h>
+#endif
+
+namespace {
+constexpr char          REGION_MAGIC[4] = {'W', 'T', 'R', 'G'};
+constexpr std::uint32_t REGION_VERSION  = 1;
+constexpr size_t        HEADER_BYTES    = 16;
+constexpr size_t        INDEX_ENTRIES   = RegionStore::REGION_SIZE * RegionStore::REGION_SIZE;
+constexpr size_t        INDEX_BYTES     = INDEX_ENTRIES * 8;
+
+static_assert(std::endian::native == std::endian::little,
+              "Region files are stored little-endian; add byte swapping for this platform");
+
+inline std::uint32_t readU32(const unsigned char* p) {
+    std::uint32_t v;
+    std::memcpy(&v, p, sizeof(v));
+    return v;
+}
+
+inline void writeU32(std::ostream& os, std::uint32_t v) {
+    os.write(reinterpret_cast<const char*>(&v), sizeof(v));
+}
+
+// Floor division that matches worldPixelsToChunk for negative chunk coords
+inline std::int32_t floorDiv(std::int32_t a, std::int32_t b) {
+    return (a >= 0) ? (a / b) : ((a - b + 1) / b);
+}
+} // namespace
+
+// Read-only view of a whole region file
+struct RegionStore::Mapping {
+    const unsigned char* data = nullptr;
+    size_t size = 0;
+#if defined(_WIN32)
+    HANDLE file = INVALID_HANDLE_VALUE;
+    HANDLE mapping = nullptr;
+#endif
+
+    bool open(const std::filesystem::path& path) {
+#if defined(_WIN32)
+        file = CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE, nullptr,
+                           OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (file == INVALID_HANDLE_VALUE) return false;
+        LARGE_INTEGER len{};
+        if (!GetFileSizeEx(file, &len) || len.QuadPart == 0) return false;
+        mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (!mapping) return false;
+        data = static_cast<const unsigned char*>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+        size = static_cast<size_t>(len.QuadPart);
+        return data != nullptr;
+#else
+        const int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) return false;
+        struct stat st{};
+        if (::fstat(fd, &st) != 0 || st.st_size <= 0) {
+            ::close(fd);
+            return false;
+        }
+        void* p = ::mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ, MAP_SHARED, fd, 0);
+        ::close(fd); // the mapping keeps the file referenced
+        if (p == MAP_FAILED) return false;
+        data = static_cast<const unsigned char*>(p);
+        size = static_cast<size_t>(st.st_size);
+        return true;
+#endif
+    }
+
+    ~Mapping() {
+#if defined(_WIN32)
+        if (data) UnmapViewOfFile(data);
+        if (mapping) CloseHandle(mapping);
+        if (file != INVALID_HANDLE_VALUE) CloseHandle(file);
+#else
+        if (data) ::munmap(const_cast<unsigned char*>(data), size);
+#endif
+    }
+};
+
+RegionStore::RegionStore(std::filesystem::path dir) : dir_(std::move(dir)) {
+    std::error_code ec;
+    std::filesystem::create_directories(dir_, ec);
+    if (ec) {
+        throw std::runtime_error("Failed to create region directory: " + dir_.string());
+    }
+}
+
+RegionStore::~RegionStore() = default;
+
+RegionStore::RegionCoord RegionStore::regionOf(ChunkCoord cc) {
+    return {floorDiv(cc.x, REGION_SIZE), floorDiv(cc.y, REGION_SIZE)};
+}
+
+unsigned RegionStore::slotOf(ChunkCoord cc) {
+    const RegionCoord rc = regionOf(cc);
+    const unsigned lx = static_cast<unsigned>(cc.x - rc.x * REGION_SIZE);
+    const unsigned ly = static_cast<unsigned>(cc.y - rc.y * REGION_SIZE);
+    return ly * REGION_SIZE + lx;
+}
+
+std::filesystem::path RegionStore::pathFor(RegionCoord rc) const {
+    return dir_ / ("r." + std::to_string(rc.x) + "." + std::to_string(rc.y) + ".wtr");
+}
+
+const RegionStore::Mapping* RegionStore::mappingFor(RegionCoord rc) {
+    auto it = mappings_.find(rc);
+    if (it != mappings_.end()) return it->second.get();
+
+    if (mappings_.size() >= MAX_MAPPED_REGIONS) {
+        mappings_.erase(mappings_.begin()); // any victim will do; remapping is cheap
+    }
+
+    auto m = std::make_unique<Mapping>();
+    const bool valid = m->open(pathFor(rc))
+                    && m->size >= HEADER_BYTES + INDEX_BYTES
+                    && std::memcmp(m->data, REGION_MAGIC, sizeof(REGION_MAGIC)) == 0
+                    && readU32(m->data + 4)  == REGION_VERSION
+                    && readU32(m->data + 8)  == CHUNK_W
+                    && readU32(m->data + 12) == CHUNK_H;
+    if (!valid) m.reset();
+    return mappings_.emplace(rc, std::move(m)).first->second.get();
+}
+
+bool RegionStore::load(ChunkCoord cc, Chunk& chunk) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    const Mapping* m = mappingFor(regionOf(cc));
+    if (!m) return false;
+
+    const unsigned char* entry = m->data + HEADER_BYTES + slotOf(cc) * 8;
+    const std::uint32_t offset = readU32(entry);
+    const std::uint32_t size   = readU32(entry + 4);
+    const size_t expected = size_t(CHUNK_W) * CHUNK_H * sizeof(TileID);
+    if (offset == 0 || size != expected || size_t(offset) + size > m->size) return false;
+
+    chunk.loadTiles(reinterpret_cast<const TileID*>(m->data + offset));
+    return true;
+}
+
+bool RegionStore::save(const Chunk& chunk) {
+    const ChunkCoord cc = chunk.coord();
+    const RegionCoord rc = regionOf(cc);
+    const std::filesystem::path path = pathFor(rc);
+    const std::uint32_t payload = static_cast<std::uint32_t>(size_t(CHUNK_W) * CHUNK_H * sizeof(TileID));
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    mappings_.erase(rc); // file is about to change; remap on next load
+
+    std::error_code ec;
+    if (!std::filesystem::exists(path, ec)) {
+        std::ofstream create(path, std::ios::binary);
+        if (!create) return false;
+        create.write(REGION_MAGIC, sizeof(REGION_MAGIC));
+        writeU32(create, REGION_VERSION);
+        writeU32(create, CHUNK_W);
+        writeU32(create, CHUNK_H);
+        const std::vector<char> emptyIndex(INDEX_BYTES, 0);
+        create.write(emptyIndex.data(), static_cast<std::streamsize>(emptyIndex.size()));
+        if (!create.flush()) {
+            // A truncated header would make the file look foreign from now on
+            create.close();
+            std::filesystem::remove(path, ec);
+            return false;
+        }
+    }
+
+    std::fstream f(path, std::ios::binary | std::ios::in | std::ios::out);
+    if (!f) return false;
+
+    std::array<unsigned char, HEADER_BYTES> header{};
+    f.read(reinterpret_cast<char*>(header.data()), header.size());
+    if (!f || std::memcmp(header.data(), REGION_MAGIC, sizeof(REGION_MAGIC)) != 0 ||
+        readU32(header.data() + 4) != REGION_VERSION ||
+        readU32(header.data() + 8) != CHUNK_W || readU32(header.data() + 12) != CHUNK_H) {
+        return false; // foreign or outdated file: never overwrite it
+    }
+
+    const std::streamoff entryPos = static_cast<std::streamoff>(HEADER_BYTES + slotOf(cc) * 8);
+    std::array<unsigned char, 8> entry{};
+    f.seekg(entryPos);
+    f.read(reinterpret_cast<char*>(entry.data()), entry.size());
+    if (!f) return false;
+
+    std::uint32_t offset = readU32(entry.data());
+    if (offset == 0 || readU32(entry.data() + 4) != payload) {
+        // First save of this chunk: append the payload
+        f.seekp(0, std::ios::end);
+        const std::streamoff end = f.tellp();
+        if (!f || end < 0) return false;
+        offset = static_cast<std::uint32_t>(end);
+    }
+    std::vector<TileID> tiles(CHUNK_TILES); // the file keeps raw IDs
+    chunk.copyTiles(tiles.data());
+    f.seekp(offset);
+    if (!f) return false;
+    f.write(reinterpret_cast<const char*>(tiles.data()), payload);
+    if (!f.flush()) {
+        // A short write over an existing payload leaves it half old, half new: drop
+        // the slot (best effort) so the chunk regenerates rather than loading that
+        f.clear();
+        f.seekp(entryPos);
+        writeU32(f, 0);
+        writeU32(f, 0);
+        return false;
+    }
+
+    // The index only points at the payload once it is fully written
+    f.seekp(entryPos);
+    if (!f) return false;
+    writeU32(f, offset);
+    writeU32(f, payload);
+    return static_cast<bool>(f.flush());
+}
+
+bool RegionStore::erase(ChunkCoord cc) {
+    const RegionCoord rc = regionOf(cc);
+    const std::filesystem::path path = pathFor(rc);
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::error_code ec;
+    if (!std::filesystem::exists(path, ec)) return !ec; // nothing saved
+
+    mappings_.erase(rc); // file is about to change; remap on next load
+    std::fstream f(path, std::ios::binary | std::ios::in | std::ios::out);
+    if (!f) return false;
+
+    std::array<unsigned char, HEADER_BYTES> header{};
+    f.read(reinterpret_cast<char*>(header.data()), header.size());
+    if (!f || std::memcmp(header.data(), REGION_MAGIC, sizeof(REGION_MAGIC)) != 0 ||
+        readU32(header.data() + 4) != REGION_VERSION ||
+        readU32(header.data() + 8) != CHUNK_W || readU32(header.data() + 12) != CHUNK_H) {
+        return false; // foreign or outdated file: never overwrite it
+    }
+
+    // The payload stays behind as dead space; a later save of the chunk appends anew
+    f.seekp(static_cast<std::streamoff>(HEADER_BYTES + slotOf(cc) * 8));
+    if (!f) return false;
+    writeU32(f, 0);
+    writeU32(f, 0);
+    return static_cast<bool>(f.flush());
+}
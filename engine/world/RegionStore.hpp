@@ -0,0 +1,64 @@
+#pragma once
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include "engine/tile/Coords.hpp"
+#include "engine/tile/TileTypes.hpp"
+
+class Chunk; // forward declaration
+
+// On-disk chunk storage grouped into region files of REGION_SIZE x REGION_SIZE chunks.
+//
+// File layout (little-endian):
+//   header  : magic "WTRG", version, chunk width, chunk height   (16 bytes)
+//   index   : REGION_SIZE^2 entries of {offset, size}             (u32 each, 0 = absent)
+//   payload : raw TileID arrays, row-major, appended as chunks are first saved
+//
+// Region files are memory-mapped for reads, so loading copies tiles straight
+// from the page cache into the chunk. All methods are thread-safe.
+class RegionStore {
+public:
+    static constexpr int REGION_SIZE = 32;
+
+    explicit RegionStore(std::filesystem::path dir);
+    ~RegionStore();
+
+    RegionStore(const RegionStore&) = delete;
+    RegionStore& operator=(const RegionStore&) = delete;
+
+    // Fill chunk tiles from disk; false if the chunk was never saved or the file is unusable
+    bool load(ChunkCoord cc, Chunk& chunk);
+    // False if the chunk could not be written in full; the index then never points
+    // at a partial payload
+    bool save(const Chunk& chunk);
+    // Forget a saved chunk so it regenerates; true if nothing is stored for it now
+    bool erase(ChunkCoord cc);
+
+    const std::filesystem::path& directory() const { return dir_; }
+
+private:
+    struct Mapping; // platform file mapping, defined in RegionStore.cpp
+
+    struct RegionCoord {
+        std::int32_t x{}, y{};
+        bool operator==(const RegionCoord& o) const noexcept { return x == o.x && y == o.y; }
+    };
+    struct RegionCoordHash {
+        size_t operator()(const RegionCoord& r) const noexcept {
+            return ChunkCoordHash{}(ChunkCoord{r.x, r.y});
+        }
+    };
+
+    static RegionCoord regionOf(ChunkCoord cc);
+    static unsigned slotOf(ChunkCoord cc);
+    std::filesystem::path pathFor(RegionCoord rc) const;
+    const Mapping* mappingFor(RegionCoord rc); // null if the region file does not exist
+
+    std::filesystem::path dir_;
+    std::mutex mutex_;
+    // Cached mappings; a null entry remembers that the file does not exist
+    std::unordered_map<RegionCoord, std::unique_ptr<Mapping>, RegionCoordHash> mappings_;
+    static constexpr size_t MAX_MAPPED_REGIONS = 16;
+};
@@ -0,0 +1,42 @@
+#pragma once
+#include <array>
+#include <memory>
+#include "engine/tile/Coords.hpp"
+#include "engine/tile/Terrain.hpp"
+#include "engine/world/ChunkTable.hpp"
+
+// World y of the highest opaque tile in every world column (smaller y is higher up).
+//
+// Columns are stored in chunk-wide strips that live for the whole session, so what
+// was learned from a chunk survives its eviction. A strip starts out at the
+// generator's terrain surface until resident chunks say otherwise; LightEngine
+// keeps it current as chunks load and tiles change.
+class SkyHeightmap {
+public:
+    int  top(int tx)                { return column(tx); }
+    void setTop(int tx, int worldY) { column(tx) = worldY; }
+
+    size_t stripCount() const { return strips_.size(); }
+
+private:
+    using Strip = SurfaceStrip;
+
+    int& column(int tx) {
+        const int cx = tileToChunk(tx, 0).x;
+        if (!cached_ || cachedX_ != cx) {
+            std::unique_ptr<Strip>* slot = strips_.find(ChunkCoord{cx, 0});
+            if (!slot) {
+                auto strip = std::make_unique<Strip>();
+                terrainSurfaceStrip(cx, *strip);
+                slot = &strips_.insert(ChunkCoord{cx, 0}, std::move(strip));
+            }
+            cached_ = slot->get(); // strips are heap-pinned; rehashing only moves the pointers
+            cachedX_ = cx;
+        }
+        return (*cached_)[tx - cx * static_cast<int>(CHUNK_W)];
+    }
+
+    ChunkTable<std::unique_ptr<Strip>> strips_; // keyed by {chunk x, 0}
+    Strip* cached_ = nullptr;
+    int cachedX_ = 0;
+};
@@ -0,0 +1,36 @@
+#pragma once
+#include <array>
+#include <atomic>
+
+// Hands the latest of a stream of values from one writer thread to one reader
+// thread without locks, and without either side ever waiting for the other.
+//
+// Three slots: the writer fills its back slot and swaps it for the shared middle
+// one; the reader, when the middle slot holds something newer, swaps it for its
+// front slot. Values the reader didn't get to in time are skipped. Slots are
+// reused, so a T holding vectors keeps their capacity from one hand-off to the next.
+template <class T>
+class SnapshotBuffer {
+public:
+    // Writer: fill back(), then publish() it
+    T& back() { return slots_[back_]; }
+    void publish() { back_ = middle_.exchange(back_ | FRESH, std::memory_order_acq_rel) & INDEX; }
+
+    // Reader: takes the newest published value, if there is one it hasn't seen;
+    // returns whether front() changed. front() starts out default-constructed.
+    bool acquire() {
+        if (!(middle_.load(std::memory_order_relaxed) & FRESH)) return false;
+        front_ = middle_.exchange(front_, std::memory_order_acq_rel) & INDEX;
+        return true;
+    }
+    const T& front() const { return slots_[front_]; }
+
+private:
+    static constexpr unsigned INDEX = 3; // slot index bits of middle_
+    static constexpr unsigned FRESH = 4; // middle slot not yet taken by the reader
+
+    std::array<T, 3> slots_{};
+    unsigned back_ = 0;  // writer only
+    unsigned front_ = 1; // reader only
+    std::atomic<unsigned> middle_{2};
+};
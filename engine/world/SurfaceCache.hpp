@@ -0,0 +1,42 @@
+#pragma once
+#include <memory>
+#include <vector>
+#include "engine/tile/Coords.hpp"
+#include "engine/tile/Terrain.hpp"
+#include "engine/world/ChunkTable.hpp"
+
+// Generated terrain surface per chunk column, computed once and shared by every
+// chunk stacked in that column (generation and the cave wall layer both need it).
+//
+// Strips are immutable and reference counted: resident chunks and their in-flight
+// jobs hold one, and trim() drops the columns nobody holds any more, so the cache
+// is evicted along with the chunks. Owner thread only; workers just read the
+// strips they were handed.
+class SurfaceCache {
+public:
+    using StripRef = std::shared_ptr<const SurfaceStrip>;
+
+    StripRef column(int cx) {
+        const ChunkCoord key{cx, 0};
+        if (StripRef* slot = strips_.find(key)) return *slot;
+        auto strip = std::make_shared<SurfaceStrip>();
+        terrainSurfaceStrip(cx, *strip);
+        return strips_.insert(key, std::move(strip));
+    }
+
+    // Forget the columns only the cache still refers to; returns how many went
+    size_t trim() {
+        scratch_.clear();
+        strips_.forEach([&](ChunkCoord key, StripRef& strip) {
+            if (strip.use_count() == 1) scratch_.push_back(key);
+        });
+        for (const ChunkCoord& key : scratch_) strips_.erase(key);
+        return scratch_.size();
+    }
+
+    size_t size() const { return strips_.size(); }
+
+private:
+    ChunkTable<StripRef> strips_; // keyed by {chunk x, 0}
+    std::vector<ChunkCoord> scratch_;
+};
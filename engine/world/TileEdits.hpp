@@ -0,0 +1,53 @@
+#pragma once
+#include <algorithm>
+#include <cstdlib>
+#include <vector>
+#include "engine/tile/TileTypes.hpp"
+
+// One tile write in world tile coordinates, for World::applyEdits
+struct TileEdit {
+    int tx{};
+    int ty{};
+    TileID id{Tile::Air};
+};
+
+// Shape helpers: append the edits for a shape to out (world tile coordinates).
+// Later edits to the same tile win when the batch is applied.
+namespace TileEdits {
+
+// Filled rectangle between two corners, inclusive
+inline void rect(std::vector<TileEdit>& out, int x0, int y0, int x1, int y1, TileID id) {
+    if (x0 > x1) std::swap(x0, x1);
+    if (y0 > y1) std::swap(y0, y1);
+    out.reserve(out.size() + size_t(x1 - x0 + 1) * size_t(y1 - y0 + 1));
+    for (int y = y0; y <= y1; ++y) {
+        for (int x = x0; x <= x1; ++x) out.push_back({x, y, id});
+    }
+}
+
+// Filled disc of the given radius in tiles
+inline void circle(std::vector<TileEdit>& out, int cx, int cy, int radius, TileID id) {
+    if (radius < 0) return;
+    const int r2 = radius * radius + radius; // +r rounds the rim like a midpoint circle
+    for (int dy = -radius; dy <= radius; ++dy) {
+        for (int dx = -radius; dx <= radius; ++dx) {
+            if (dx * dx + dy * dy <= r2) out.push_back({cx + dx, cy + dy, id});
+        }
+    }
+}
+
+// 1-tile wide Bresenham line, both endpoints included
+inline void line(std::vector<TileEdit>& out, int x0, int y0, int x1, int y1, TileID id) {
+    const int dx = std::abs(x1 - x0), sx = x0 < x1 ? 1 : -1;
+    const int dy = -std::abs(y1 - y0), sy = y0 < y1 ? 1 : -1;
+    int err = dx + dy;
+    for (;;) {
+        out.push_back({x0, y0, id});
+        if (x0 == x1 && y0 == y1) break;
+        const int e2 = 2 * err;
+        if (e2 >= dy) { err += dy; x0 += sx; }
+        if (e2 <= dx) { err += dx; y0 += sy; }
+    }
+}
+
+} // namespace TileEdits
@@ -0,0 +1,103 @@
+#include "engine/world/WorkerPool.hpp"
+#include "engine/profile/Profiler.hpp"
+#include <algorithm>
+#include <limits>
+
+WorkerPool::WorkerPool(unsigned threadCount) {
+    threadCount = std::max(1u, threadCount);
+    queues_.reserve(threadCount);
+    for (unsigned i = 0; i < threadCount; ++i) {
+        queues_.push_back(std::make_unique<Queue>());
+    }
+    threads_.reserve(threadCount);
+    for (unsigned i = 0; i < threadCount; ++i) {
+        threads_.emplace_back([this, i] { run(i); });
+    }
+}
+
+WorkerPool::~WorkerPool() {
+    {
+        std::lock_guard<std::mutex> lock(sleepMutex_);
+        stop_ = true;
+    }
+    wake_.notify_all();
+    for (auto& t : threads_) t.join();
+}
+
+unsigned WorkerPool::defaultThreadCount() {
+    const unsigned hw = std::thread::hardware_concurrency();
+    return hw > 1 ? hw - 1 : 1;
+}
+
+void WorkerPool::submit(Task task, std::int64_t priority) {
+    const unsigned q = nextQueue_.fetch_add(1, std::memory_order_relaxed) % queues_.size();
+    Item item{priority, nextSeq_.fetch_add(1, std::memory_order_relaxed), std::move(task)};
+    {
+        Queue& queue = *queues_[q];
+        std::lock_guard<std::mutex> lock(queue.m);
+        queue.heap.push_back(std::move(item));
+        std::push_heap(queue.heap.begin(), queue.heap.end(), later);
+    }
+    queued_.fetch_add(1, std::memory_order_release);
+
+    // Taking the lock orders this notify after any worker's predicate check
+    { std::lock_guard<std::mutex> lock(sleepMutex_); }
+    wake_.notify_one();
+}
+
+void WorkerPool::parallelFor(size_t count, const std::function<void(size_t)>& body) {
+    if (count == 0) return;
+    forCount_ = count;
+    forBody_ = &body;
+    forNext_.store(0);
+    forOpen_.store(true);
+
+    // The caller takes a share too, so one helper fewer than indices is enough
+    const size_t helpers = std::min<size_t>(threads_.size(), count - 1);
+    for (size_t i = 0; i < helpers; ++i) {
+        submit([this] { helpParallelFor(); }, std::numeric_limits<std::int64_t>::min());
+    }
+    for (size_t i; (i = forNext_.fetch_add(1)) < count;) body(i);
+
+    forOpen_.store(false);
+    while (forRunning_.load() > 0) std::this_thread::yield(); // helpers finishing their last index
+}
+
+void WorkerPool::helpParallelFor() {
+    forRunning_.fetch_add(1);
+    if (forOpen_.load()) {
+        for (size_t i; (i = forNext_.fetch_add(1)) < forCount_;) (*forBody_)(i);
+    }
+    forRunning_.fetch_sub(1);
+}
+
+bool WorkerPool::tryPop(unsigned self, Item& out) {
+    const size_t n = queues_.size();
+    // Own queue first, then steal from siblings
+    for (size_t k = 0; k < n; ++k) {
+        Queue& queue = *queues_[(self + k) % n];
+        std::lock_guard<std::mutex> lock(queue.m);
+        if (queue.heap.empty()) continue;
+        std::pop_heap(queue.heap.begin(), queue.heap.end(), later);
+        out = std::move(queue.heap.back());
+        queue.heap.pop_back();
+        queued_.fetch_sub(1, std::memory_order_relaxed);
+        return true;
+    }
+    return false;
+}
+
+void WorkerPool::run(unsigned self) {
+    WET_PROFILE_THREAD("worker");
+    Item item{};
+    for (;;) {
+        if (tryPop(self, item)) {
+            item.task();
+            item.task = nullptr; // release captures before sleeping
+            continue;
+        }
+        std::unique_lock<std::mutex> lock(sleepMutex_);
+        wake_.wait(lock, [this] { return stop_ || queued_.load(std::memory_order_acquire) > 0; });
+        if (stop_) return; // queued tasks are dropped on shutdown
+    }
+}
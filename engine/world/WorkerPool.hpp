@@ -0,0 +1,76 @@
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Small work-stealing thread pool.
+// Every worker owns a priority queue; submit() deals tasks round-robin and an
+// idle worker steals the most urgent task from its siblings. Lower priority
+// values run first, ties run in submission order.
+class WorkerPool {
+public:
+    using Task = std::function<void()>;
+
+    explicit WorkerPool(unsigned threadCount);
+    ~WorkerPool();
+
+    WorkerPool(const WorkerPool&) = delete;
+    WorkerPool& operator=(const WorkerPool&) = delete;
+
+    void submit(Task task, std::int64_t priority = 0);
+
+    // Runs body(0) .. body(count - 1) on the calling thread and on any workers that
+    // come free meanwhile (ahead of all queued tasks), and returns once every call
+    // has finished. Indices are handed out in order. One caller at a time.
+    void parallelFor(size_t count, const std::function<void(size_t)>& body);
+
+    unsigned threadCount() const { return static_cast<unsigned>(threads_.size()); }
+    size_t   queuedTasks() const { return queued_.load(std::memory_order_relaxed); }
+
+    // hardware_concurrency - 1 (the render thread keeps a core), at least 1
+    static unsigned defaultThreadCount();
+
+private:
+    struct Item {
+        std::int64_t  priority;
+        std::uint64_t seq;
+        Task          task;
+    };
+    struct Queue {
+        std::mutex        m;
+        std::vector<Item> heap; // min-heap on (priority, seq)
+    };
+
+    static bool later(const Item& a, const Item& b) {
+        return a.priority != b.priority ? a.priority > b.priority : a.seq > b.seq;
+    }
+
+    bool tryPop(unsigned self, Item& out);
+    void run(unsigned self);
+    void helpParallelFor();
+
+    std::vector<std::unique_ptr<Queue>> queues_;
+    std::vector<std::thread>            threads_;
+
+    std::mutex              sleepMutex_;
+    std::condition_variable wake_;
+    std::atomic<size_t>     queued_{0};
+    std::atomic<unsigned>   nextQueue_{0};
+    std::atomic<std::uint64_t> nextSeq_{0};
+    bool                    stop_{false}; // guarded by sleepMutex_
+
+    // parallelFor() in progress. A helper task may start after its call returned:
+    // it registers in forRunning_ before looking at forOpen_, and the caller closes
+    // forOpen_ before waiting for forRunning_ to drain, so a late helper either sees
+    // the call closed or joins the next one; count and body are only read while open.
+    std::atomic<bool>     forOpen_{false};
+    std::atomic<unsigned> forRunning_{0};
+    std::atomic<size_t>   forNext_{0};
+    size_t                forCount_ = 0;
+    const std::function<void(size_t)>* forBody_ = nullptr;
+};
@@ -1,10 +1,334 @@
 #include "engine/world/World.hpp"
+#include "engine/profile/Profiler.hpp"
 #include <cassert>
 #include <algorithm>
 #include <cmath>
+#include <cstdio>
+
+World::~World() {
+    pending_.forEach([](ChunkCoord, ChunkJob* job) { job->cancelled.store(true, std::memory_order_relaxed); });
+    for (auto& pending : pendingImposters_) {
+        pending.forEach([](ChunkCoord, ImposterJob* job) { job->cancelled.store(true, std::memory_order_relaxed); });
+    }
+    workers_.reset(); // join before the completion queue goes away
+    const SaveResult saved = saveModifiedChunks();
+    if (saved.failed > 0) {
+        std::fprintf(stderr, "World: %zu edited chunks could not be saved to %s; their edits are lost\n",
+                     saved.failed, regions_->directory().string().c_str());
+    }
+}
+
+std::unique_ptr<World::Entry> World::acquireEntry(ChunkCoord cc) {
+    if (freeEntries_.empty()) {
+        ++poolStats_.entryAllocations;
+        return std::make_unique<Entry>(cc);
+    }
+    std::unique_ptr<Entry> e = std::move(freeEntries_.back());
+    freeEntries_.pop_back();
+    ++poolStats_.entryReuses;
+    return e;
+}
+
+void World::releaseEntry(std::unique_ptr<Entry> e) {
+    if (e) e->surface.reset(); // lets surfaces_.trim() drop the column
+    if (e && freeEntries_.size() < MAX_POOLED_ENTRIES) {
+        freeEntries_.push_back(std::move(e));
+    }
+}
+
+void World::fillEntry(Entry& e, ChunkCoord cc, unsigned ambient, const std::uint8_t* skyAbove) const {
+    e.reset(cc);
+    {
+        WET_PROFILE_SCOPE("chunk.generate");
+        if (regions_ && regions_->load(cc, e.chunk)) {
+            // Saved chunks also get their generated tiles, so edits can tell when
+            // they have put every one of them back (per-thread scratch)
+            thread_local std::unique_ptr<Chunk> generated;
+            thread_local std::vector<TileID> tiles;
+            if (!generated) generated = std::make_unique<Chunk>(cc);
+            generated->reset(cc);
+            generated->generate(seed_, e.surface.get());
+            e.generatedTiles.resize(CHUNK_TILES);
+            generated->copyTiles(e.generatedTiles.data());
+            tiles.resize(CHUNK_TILES);
+            e.chunk.copyTiles(tiles.data());
+            for (size_t i = 0; i < CHUNK_TILES; ++i) e.differingTiles += tiles[i] != e.generatedTiles[i];
+        } else {
+            e.chunk.generate(seed_, e.surface.get());
+        }
+    }
+    {
+        WET_PROFILE_SCOPE("chunk.light");
+        LightMap& light = e.chunk.getLightMap();
+        for (unsigned x = 0; x < CHUNK_W; ++x) light.setSkyAbove(x, skyAbove[x]);
+        e.chunk.updateLighting();
+    }
+
+    WET_PROFILE_SCOPE("chunk.mesh");
+    const size_t capacity = e.batch.capacity();
+    e.batch.build(e.chunk, *atlas_, lightShader_, ambient);
+    if (e.batch.capacity() != capacity) {
+        vertexBufferGrowths_.fetch_add(1, std::memory_order_relaxed);
+    }
+    e.background.build(e.chunk, *e.surface);
+}
+
+World::PoolStats World::poolStats() const {
+    PoolStats stats = poolStats_;
+    stats.vertexBufferGrowths = vertexBufferGrowths_.load(std::memory_order_relaxed);
+    stats.pooledEntries = freeEntries_.size();
+    return stats;
+}
+
+std::unique_ptr<World::Entry> World::buildEntryNow(ChunkCoord cc) {
+    std::array<std::uint8_t, CHUNK_W> skyAbove;
+    light_.skyAbove(cc, skyAbove.data());
+    std::unique_ptr<Entry> e = acquireEntry(cc);
+    e->surface = surfaces_.column(cc.x);
+    fillEntry(*e, cc, currentAmbientLight_, skyAbove.data());
+    return e;
+}
+
+void World::requestChunk(ChunkCoord cc, std::int64_t priority) {
+    if (!workers_) {
+        frameJobs_.push_back({priority, FrameJob::Kind::BuildChunk, 0, cc}); // built within the frame budget
+        return;
+    }
+    if (pending_.contains(cc)) return;
+
+    ChunkJob* job;
+    if (!freeJobs_.empty()) {
+        job = freeJobs_.back();
+        freeJobs_.pop_back();
+    } else {
+        jobs_.push_back(std::make_unique<ChunkJob>());
+        job = jobs_.back().get();
+        ++poolStats_.jobAllocations;
+    }
+    job->coord = cc;
+    job->ambient = currentAmbientLight_;
+    light_.skyAbove(cc, job->skyAbove.data()); // the worker must not touch the heightmap
+    job->cancelled.store(false, std::memory_order_relaxed);
+    job->entry = acquireEntry(cc);
+    job->entry->surface = surfaces_.column(cc.x); // handed over here so workers never touch the cache
+    pending_.insert(cc, job);
+
+    // Two pointers fit std::function's small buffer, so submitting does not allocate
+    workers_->submit([this, job] {
+        if (!job->cancelled.load(std::memory_order_relaxed)) {
+            fillEntry(*job->entry, job->coord, job->ambient, job->skyAbove.data());
+        }
+        std::lock_guard<std::mutex> lock(doneMutex_);
+        done_.push_back(job);
+    }, priority);
+}
+
+void World::collectFinishedChunks() {
+    {
+        std::lock_guard<std::mutex> lock(doneMutex_);
+        doneScratch_.swap(done_);
+    }
+    for (ChunkJob* job : doneScratch_) {
+        if (!job->cancelled.load(std::memory_order_relaxed)) {
+            pending_.erase(job->coord);
+            if (!lightShader_.active() && job->ambient != currentAmbientLight_) {
+                job->entry->batch.markDirty(); // baked for an ambient that changed while in flight
+            }
+            insertEntry(std::move(job->entry));
+        } else {
+            releaseEntry(std::move(job->entry));
+        }
+        freeJobs_.push_back(job);
+    }
+    doneScratch_.clear();
+}
+
+void World::cancelPending(ChunkCoord cc) {
+    ChunkJob* job = pending_.take(cc);
+    if (job) job->cancelled.store(true, std::memory_order_relaxed);
+}
+
+unsigned World::lodLevelFor(const sf::View& view) const {
+    const float viewWidth = view.getSize().x;
+    if (!std::isfinite(viewWidth) || viewWidth <= 0.f) return 0;
+
+    // Coarsen until one cell covers at least MIN_CELL_PIXELS screen pixels
+    const float tilePixels = static_cast<float>(TILE_SIZE) * static_cast<float>(screenSize_.x) / viewWidth;
+    unsigned level = 0;
+    while (level < MAX_LOD_LEVEL && tilePixels * static_cast<float>(1u << level) < MIN_CELL_PIXELS) ++level;
+    return level;
+}
+
+size_t World::imposterCount() const {
+    size_t n = 0;
+    for (const auto& level : imposters_) n += level.size();
+    return n;
+}
+
+void World::requestImposter(unsigned level, ChunkCoord ic, std::int64_t priority) {
+    if (!workers_) {
+        frameJobs_.push_back({priority, FrameJob::Kind::BuildImposter, level, ic});
+        return;
+    }
+    if (pendingImposters_[level].contains(ic)) return;
+
+    ImposterJob* job;
+    if (!freeImposterJobs_.empty()) {
+        job = freeImposterJobs_.back();
+        freeImposterJobs_.pop_back();
+    } else {
+        imposterJobs_.push_back(std::make_unique<ImposterJob>());
+        job = imposterJobs_.back().get();
+    }
+    job->coord = ic;
+    job->level = level;
+    job->ambient = currentAmbientLight_;
+    job->cancelled.store(false, std::memory_order_relaxed);
+    if (!job->imposter) job->imposter = std::make_unique<Imposter>();
+    pendingImposters_[level].insert(ic, job);
+
+    workers_->submit([this, job] {
+        if (!job->cancelled.load(std::memory_order_relaxed)) {
+            WET_PROFILE_SCOPE("imposter.build");
+            job->imposter->batch.generate(job->coord, job->level, seed_);
+            job->imposter->batch.build(*atlas_, lightShader_, job->ambient);
+        }
+        std::lock_guard<std::mutex> lock(doneMutex_);
+        doneImposters_.push_back(job);
+    }, priority);
+}
+
+void World::collectFinishedImposters() {
+    {
+        std::lock_guard<std::mutex> lock(doneMutex_);
+        doneImpostersScratch_.swap(doneImposters_);
+    }
+    for (ImposterJob* job : doneImpostersScratch_) {
+        if (!job->cancelled.load(std::memory_order_relaxed)) {
+            pendingImposters_[job->level].erase(job->coord);
+            if (!lightShader_.active() && job->ambient != currentAmbientLight_) {
+                job->imposter->batch.markDirty(); // baked for an ambient that changed while in flight
+            }
+            job->imposter->lastTouched = frame_;
+            imposters_[job->level].insert(job->coord, std::move(job->imposter));
+        }
+        freeImposterJobs_.push_back(job); // a cancelled job keeps its imposter for reuse
+    }
+    doneImpostersScratch_.clear();
+}
+
+void World::updateImposters(ChunkCoord cmin, ChunkCoord cmax, ChunkCoord camChunk) {
+    // Load range at the current level, nearest first
+    const int lo = static_cast<int>(lod_);
+    const ChunkCoord imin{cmin.x >> lo, cmin.y >> lo}, imax{cmax.x >> lo, cmax.y >> lo};
+    if (lod_ > 0) {
+        const ChunkCoord camImposter{camChunk.x >> lo, camChunk.y >> lo};
+        for (int iy = imin.y; iy <= imax.y; ++iy) {
+            for (int ix = imin.x; ix <= imax.x; ++ix) {
+                const ChunkCoord ic{ix, iy};
+                if (std::unique_ptr<Imposter>* im = imposters_[lod_].find(ic)) {
+                    (*im)->lastTouched = frame_; // remeshed by prepareFrame once in view
+                    continue;
+                }
+                const std::int64_t dx = ix - camImposter.x;
+                const std::int64_t dy = iy - camImposter.y;
+                requestImposter(lod_, ic, dx * dx + dy * dy);
+            }
+        }
+    }
+
+    for (unsigned level = 1; level <= MAX_LOD_LEVEL; ++level) {
+        // Jobs for another level or out of range are no longer wanted
+        imposterScratch_.clear();
+        pendingImposters_[level].forEach([&](ChunkCoord ic, ImposterJob*) {
+            if (level != lod_ || ic.x < imin.x || ic.x > imax.x || ic.y < imin.y || ic.y > imax.y) {
+                imposterScratch_.push_back({level, ic});
+            }
+        });
+        for (const auto& [l, ic] : imposterScratch_) {
+            if (ImposterJob* job = pendingImposters_[l].take(ic)) job->cancelled.store(true, std::memory_order_relaxed);
+        }
+
+        // Imposters stay a while after they leave the view, to cover zooming back
+        imposterScratch_.clear();
+        imposters_[level].forEach([&](ChunkCoord ic, std::unique_ptr<Imposter>& im) {
+            if (im->lastTouched + IMPOSTER_KEEP_FRAMES < frame_) imposterScratch_.push_back({level, ic});
+        });
+        for (const auto& [l, ic] : imposterScratch_) imposters_[l].erase(ic);
+    }
+}
+
+bool World::gatherImposter(unsigned level, ChunkCoord ic) const {
+    auto add = [](std::vector<ImposterBatch*>& list, ImposterBatch* imposter) {
+        if (std::find(list.begin(), list.end(), imposter) == list.end()) list.push_back(imposter);
+    };
+    if (const std::unique_ptr<Imposter>* im = imposters_[level].find(ic)) {
+        add(imposterDrawScratch_, &(*im)->batch);
+        return true;
+    }
+    // Not ready yet: show the coarser parent, else whatever finer children exist
+    if (level < MAX_LOD_LEVEL) {
+        if (const std::unique_ptr<Imposter>* im = imposters_[level + 1].find(ChunkCoord{ic.x >> 1, ic.y >> 1})) {
+            add(fallbackDrawScratch_, &(*im)->batch);
+            return true;
+        }
+    }
+    bool found = false;
+    if (level > 1) {
+        for (int dy = 0; dy < 2; ++dy) {
+            for (int dx = 0; dx < 2; ++dx) {
+                const ChunkCoord child{ic.x * 2 + dx, ic.y * 2 + dy};
+                if (const std::unique_ptr<Imposter>* im = imposters_[level - 1].find(child)) {
+                    add(fallbackDrawScratch_, &(*im)->batch);
+                    found = true;
+                }
+            }
+        }
+    }
+    return found;
+}
+
+void World::setSaveDirectory(const std::filesystem::path& dir) {
+    saveModifiedChunks(); // flush to the previous location first
+    regions_ = std::make_unique<RegionStore>(dir);
+}
+
+bool World::saveIfModified(Entry& e) {
+    if (!e.modified || !regions_) return true;
+    const bool failedBefore = e.nextSaveAttempt != 0;
+    // Edits that put the generated tiles back need no file; dropping the slot also
+    // keeps an older saved copy from overriding the generator
+    const bool stored = e.differingTiles == 0 ? regions_->erase(e.chunk.coord()) : regions_->save(e.chunk);
+    if (stored) {
+        e.modified = false;
+        e.nextSaveAttempt = 0;
+        if (failedBefore) --unsavedChunks_;
+        return true;
+    }
+    e.nextSaveAttempt = frame_ + SAVE_RETRY_FRAMES;
+    if (!failedBefore) ++unsavedChunks_;
+    return false;
+}
+
+World::SaveResult World::saveModifiedChunks() {
+    SaveResult result;
+    if (!regions_) return result;
+    chunks_.forEach([&](ChunkCoord, std::unique_ptr<Entry>& e) {
+        if (!e->modified) return;
+        if (saveIfModified(*e)) ++result.written;
+        else ++result.failed;
+    });
+    return result;
+}
 
 void World::ensureVisible(const sf::View& view, float inflatePixels, int keepMarginChunks) {
+    ensureVisible(view, ViewMotion{}, inflatePixels, keepMarginChunks);
+}
+
+void World::ensureVisible(const sf::View& view, const ViewMotion& motion,
+                          float inflatePixels, int keepMarginChunks) {
     assert(atlas_ && "World requires a valid TileAtlas*");
+    WET_PROFILE_SCOPE("world.ensureVisible");
     
     // Validate input parameters
     if (inflatePixels < 0.f || !std::isfinite(inflatePixels)) {
@@ -23,81 +347,244 @@ void World::ensureVisible(const sf::View& view, float inflatePixels, int keepMar
         return; // Invalid view, skip processing
     }
 
-    const float left   = center.x - size.x * 0.5f - inflatePixels;
-    const float right  = center.x + size.x * 0.5f + inflatePixels;
-    const float top    = center.y - size.y * 0.5f - inflatePixels;
-    const float bottom = center.y + size.y * 0.5f + inflatePixels;
+    // Predicted view after the lookahead: moved along the velocity and, while
+    // zooming out, grown by the current zoom rate (capped to avoid huge bursts)
+    sf::Vector2f aheadCenter = center;
+    sf::Vector2f aheadSize = size;
+    const float lookahead = std::clamp(motion.lookaheadSeconds, 0.f, 2.f);
+    if (std::isfinite(motion.velocity.x) && std::isfinite(motion.velocity.y)) {
+        aheadCenter += motion.velocity * lookahead;
+    }
+    if (std::isfinite(motion.zoomRate) && motion.zoomRate > 0.f) {
+        aheadSize *= std::min(4.f, std::exp(motion.zoomRate * lookahead));
+    }
+
+    // Load range: current view and predicted view, both inflated
+    const float left   = std::min(center.x - size.x * 0.5f, aheadCenter.x - aheadSize.x * 0.5f) - inflatePixels;
+    const float right  = std::max(center.x + size.x * 0.5f, aheadCenter.x + aheadSize.x * 0.5f) + inflatePixels;
+    const float top    = std::min(center.y - size.y * 0.5f, aheadCenter.y - aheadSize.y * 0.5f) - inflatePixels;
+    const float bottom = std::max(center.y + size.y * 0.5f, aheadCenter.y + aheadSize.y * 0.5f) + inflatePixels;
 
     const ChunkCoord cmin = worldPixelsToChunk(left,  top);
     const ChunkCoord cmax = worldPixelsToChunk(right, bottom);
 
-    // Load visible chunks
-    for (int cy = cmin.y; cy <= cmax.y; ++cy) {
-        for (int cx = cmin.x; cx <= cmax.x; ++cx) {
-            ChunkCoord key{cx, cy};
-            if (chunks_.find(key) != chunks_.end()) continue;
-
-            Entry e{Chunk(key)};
-            e.chunk.generate(seed_);
-            e.chunk.updateLighting(currentAmbientLight_);
-            e.batch.build(e.chunk, *atlas_);
-            chunks_.emplace(key, std::move(e));
+    // Chunks actually on screen
+    const ChunkCoord vmin = worldPixelsToChunk(center.x - size.x * 0.5f, center.y - size.y * 0.5f);
+    const ChunkCoord vmax = worldPixelsToChunk(center.x + size.x * 0.5f, center.y + size.y * 0.5f);
+
+    // Pick up chunks and imposters the workers finished since last frame, and carry
+    // light into the new chunks before looking for meshes to redo
+    collectFinishedChunks();
+    collectFinishedImposters();
+    flushLight();
+    ++frame_;
+    frameJobs_.clear();
+
+    const ChunkCoord camChunk = worldPixelsToChunk(center.x, center.y);
+    lod_ = lodLevelFor(view);
+    updateImposters(cmin, cmax, camChunk);
+    if (lod_ == 0) {
+        countArrivals(vmin, vmax);
+
+        // Touch resident chunks in the load range, queue the dirty ones outside the
+        // draw list (prepareFrame has those) for a refresh and request the missing
+        // ones: on-screen chunks first, then prefetch, each nearest first
+        for (int cy = cmin.y; cy <= cmax.y; ++cy) {
+            for (int cx = cmin.x; cx <= cmax.x; ++cx) {
+                const ChunkCoord key{cx, cy};
+                const std::int64_t dx = cx - camChunk.x;
+                const std::int64_t dy = cy - camChunk.y;
+                const bool onScreen = cx >= vmin.x && cx <= vmax.x && cy >= vmin.y && cy <= vmax.y;
+                const std::int64_t priority = dx * dx + dy * dy + (onScreen ? 0 : PREFETCH_PRIORITY);
+
+                if (std::unique_ptr<Entry>* slot = chunks_.find(key)) {
+                    Entry& e = **slot;
+                    touch(e);
+                    const bool drawn = cx >= vmin.x - 1 && cx <= vmax.x + 1 && cy >= vmin.y - 1 && cy <= vmax.y + 1;
+                    if (!drawn && e.dirty()) frameJobs_.push_back({priority, FrameJob::Kind::RefreshChunk, 0, key});
+                    continue;
+                }
+                requestChunk(key, priority);
+            }
         }
+    } else {
+        // Zoomed out: full chunks are neither loaded nor touched, so the resident
+        // ones age out through the LRU pass below
+        hasVisible_ = false; // prefetch arrivals only count full chunks
     }
 
-    // Prune far chunks and enforce memory limits
+    runFrameJobs();
+    flushLight(); // chunks built inline just now; their neighbours are remeshed next frame
+
+    // Unload range: the load range grown by keepMarginChunks, so chunks at the edge don't thrash
     const int xmin = cmin.x - keepMarginChunks;
     const int xmax = cmax.x + keepMarginChunks;
     const int ymin = cmin.y - keepMarginChunks;
     const int ymax = cmax.y + keepMarginChunks;
 
-    std::vector<ChunkCoord> toErase;
-    toErase.reserve(chunks_.size());
-    
-    // First pass: mark chunks outside visible area
-    for (const auto& kv : chunks_) {
-        const ChunkCoord cc = kv.first;
-        if (cc.x < xmin || cc.x > xmax || cc.y < ymin || cc.y > ymax)
-            toErase.push_back(cc);
+    // Cancel generation for chunks that scrolled out of range before they were built
+    cancelScratch_.clear();
+    pending_.forEach([&](ChunkCoord cc, ChunkJob*) {
+        if (cc.x < xmin || cc.x > xmax || cc.y < ymin || cc.y > ymax) cancelScratch_.push_back(cc);
+    });
+    for (const ChunkCoord& cc : cancelScratch_) cancelPending(cc);
+
+    // Walk the LRU list from the cold end. Chunks touched this frame sit at the hot
+    // end, so the walk only visits chunks outside the load range. Those beyond the
+    // unload range go; the rest stay cached while we are within the memory budget.
+    Entry* e = lruTail_;
+    while (e && e->lastTouched != frame_) {
+        Entry* prev = e->lruPrev;
+        const ChunkCoord cc = e->chunk.coord();
+        const bool outside = cc.x < xmin || cc.x > xmax || cc.y < ymin || cc.y > ymax;
+        if (outside || residentBytes_ > memoryBudget_) {
+            evict(cc);
+        }
+        e = prev;
     }
-    
-    // Second pass: enforce hard memory limit if needed
-    if (chunks_.size() > maxChunks_) {
-        // Calculate distances from camera center and sort by distance
-        const ChunkCoord camChunk = worldPixelsToChunk(view.getCenter().x, view.getCenter().y);
-        
-        std::vector<std::pair<int, ChunkCoord>> distances;
-        for (const auto& kv : chunks_) {
-            const ChunkCoord cc = kv.first;
-            // Skip chunks already marked for removal
-            if (std::find(toErase.begin(), toErase.end(), cc) != toErase.end()) continue;
-            
-            const int dx = cc.x - camChunk.x;
-            const int dy = cc.y - camChunk.y;
-            const int distSq = dx * dx + dy * dy;
-            distances.emplace_back(distSq, cc);
+    surfaces_.trim(); // columns with no chunk left
+}
+
+void World::runFrameJobs() {
+    WET_PROFILE_SCOPE("world.frameJobs");
+    std::sort(frameJobs_.begin(), frameJobs_.end(),
+              [](const FrameJob& a, const FrameJob& b) { return a.priority < b.priority; });
+
+    const auto start = std::chrono::steady_clock::now();
+    size_t ran = 0;
+    while (ran < frameJobs_.size()) {
+        if (ran > 0 && frameBudget_.count() > 0 && std::chrono::steady_clock::now() - start >= frameBudget_) break;
+        runFrameJob(frameJobs_[ran++]);
+    }
+    deferredJobs_ = frameJobs_.size() - ran;
+    frameJobs_.clear();
+}
+
+void World::runFrameJob(const FrameJob& job) {
+    switch (job.kind) {
+        case FrameJob::Kind::BuildChunk:
+            if (!chunks_.contains(job.coord)) insertEntry(buildEntryNow(job.coord));
+            break;
+        case FrameJob::Kind::RefreshChunk:
+            if (std::unique_ptr<Entry>* slot = chunks_.find(job.coord)) refreshEntry(**slot);
+            break;
+        case FrameJob::Kind::BuildImposter: {
+            if (imposters_[job.level].contains(job.coord)) break;
+            WET_PROFILE_SCOPE("imposter.build");
+            auto imposter = std::make_unique<Imposter>();
+            imposter->batch.generate(job.coord, job.level, seed_);
+            imposter->batch.build(*atlas_, lightShader_, currentAmbientLight_);
+            imposter->lastTouched = frame_;
+            imposters_[job.level].insert(job.coord, std::move(imposter));
+            break;
         }
-        
-        // Sort by distance (farthest first)
-        std::sort(distances.begin(), distances.end(), [](const auto& a, const auto& b) {
-            return a.first > b.first; // Compare only the distance (first element)
-        });
-        
-        // Mark excess chunks for removal
-        const size_t chunksToKeep = maxChunks_ - toErase.size();
-        if (distances.size() > chunksToKeep) {
-            for (size_t i = chunksToKeep; i < distances.size(); ++i) {
-                toErase.push_back(distances[i].second);
+    }
+}
+
+void World::refreshEntry(Entry& e) {
+    if (e.chunk.isLightingDirty()) {
+        WET_PROFILE_SCOPE("relight.chunk");
+        e.chunk.updateLighting(); // relit from scratch, so remesh everything
+        e.batch.markDirty();
+    }
+    if (e.background.isDirty()) {
+        WET_PROFILE_SCOPE("remesh.background");
+        e.background.build(e.chunk, *e.surface);
+    }
+    if (e.batch.isDirty()) {
+        WET_PROFILE_SCOPE("remesh.tiles");
+        e.batch.update(e.chunk, *atlas_, lightShader_, currentAmbientLight_);
+    }
+}
+
+void World::countArrivals(ChunkCoord vmin, ChunkCoord vmax) {
+    if (hasVisible_) {
+        for (int cy = vmin.y; cy <= vmax.y; ++cy) {
+            for (int cx = vmin.x; cx <= vmax.x; ++cx) {
+                const bool wasVisible = cx >= visibleMin_.x && cx <= visibleMax_.x &&
+                                        cy >= visibleMin_.y && cy <= visibleMax_.y;
+                if (wasVisible) continue;
+                if (chunks_.contains(ChunkCoord{cx, cy})) ++prefetchStats_.readyOnArrival;
+                else                                                   ++prefetchStats_.missedOnArrival;
             }
         }
     }
-    
-    for (const ChunkCoord& cc : toErase) chunks_.erase(cc);
+    visibleMin_ = vmin;
+    visibleMax_ = vmax;
+    hasVisible_ = true;
 }
 
-void World::draw(sf::RenderTarget& t, sf::RenderStates s) const {
-    // Get view bounds for frustum culling
-    const sf::View view = t.getView();
+World::Entry& World::insertEntry(std::unique_ptr<Entry> entry) {
+    const ChunkCoord cc = entry->chunk.coord();
+    Entry& e = *chunks_.insert(cc, std::move(entry));
+    e.lastTouched = frame_;
+    e.lruPrev = nullptr;
+    e.lruNext = lruHead_;
+    if (lruHead_) lruHead_->lruPrev = &e;
+    lruHead_ = &e;
+    if (!lruTail_) lruTail_ = &e;
+
+    e.bytes = e.memoryBytes();
+    residentBytes_ += e.bytes;
+
+    light_.chunkLoaded(cc); // exchanged on the next flushLight()
+    return e;
+}
+
+Chunk* World::lightLookup(void* world, ChunkCoord cc) {
+    std::unique_ptr<Entry>* slot = static_cast<World*>(world)->chunks_.find(cc);
+    return slot ? &(*slot)->chunk : nullptr;
+}
+
+void World::flushLight() {
+    WET_PROFILE_SCOPE("world.flushLight");
+    light_.flush();
+    for (const LightEngine::ChangedChunk& c : light_.changedChunks()) {
+        if (std::unique_ptr<Entry>* slot = chunks_.find(c.coord)) (*slot)->batch.markDirty(c.minX, c.minY, c.maxX, c.maxY);
+    }
+    light_.clearChangedChunks();
+}
+
+void World::touch(Entry& e) {
+    e.lastTouched = frame_;
+
+    // Meshes change size after edits; keep the byte count current for visible chunks
+    const size_t bytes = e.memoryBytes();
+    residentBytes_ = residentBytes_ - e.bytes + bytes;
+    e.bytes = bytes;
+
+    if (lruHead_ == &e) return;
+    // unlink
+    e.lruPrev->lruNext = e.lruNext;
+    if (e.lruNext) e.lruNext->lruPrev = e.lruPrev;
+    else           lruTail_ = e.lruPrev;
+    // push front
+    e.lruPrev = nullptr;
+    e.lruNext = lruHead_;
+    lruHead_->lruPrev = &e;
+    lruHead_ = &e;
+}
+
+void World::evict(ChunkCoord cc) {
+    std::unique_ptr<Entry>* slot = chunks_.find(cc);
+    if (!slot) return;
+    WET_PROFILE_SCOPE("world.evict");
+    Entry& e = **slot;
+    // Dropping an edit that isn't on disk would lose it: the chunk stays in the LRU
+    // list, and a later pass retries the write once SAVE_RETRY_FRAMES have passed
+    if (e.modified && regions_ && (frame_ < e.nextSaveAttempt || !saveIfModified(e))) return;
+
+    if (e.lruPrev) e.lruPrev->lruNext = e.lruNext;
+    else           lruHead_ = e.lruNext;
+    if (e.lruNext) e.lruNext->lruPrev = e.lruPrev;
+    else           lruTail_ = e.lruPrev;
+
+    residentBytes_ -= e.bytes;
+    releaseEntry(chunks_.take(cc));
+}
+
+void World::gatherDrawList(const sf::View& view) const {
+    // View bounds for frustum culling
     const sf::Vector2f center = view.getCenter();
     const sf::Vector2f size = view.getSize();
     const float left = center.x - size.x * 0.5f;
@@ -109,91 +596,153 @@ void World::draw(sf::RenderTarget& t, sf::RenderStates s) const {
     const ChunkCoord minChunk = worldPixelsToChunk(left, top);
     const ChunkCoord maxChunk = worldPixelsToChunk(right, bottom);
     
-    // First pass: Draw underground backgrounds for individual air tiles
-    for (auto& kv : chunks_) {
-        const ChunkCoord cc = kv.first;
-        
-        // Frustum culling: skip chunks outside view
-        if (cc.x < minChunk.x - 1 || cc.x > maxChunk.x + 1 ||
-            cc.y < minChunk.y - 1 || cc.y > maxChunk.y + 1) {
-            continue;
+    drawScratch_.clear();
+    fallbackDrawScratch_.clear();
+    imposterDrawScratch_.clear();
+
+    if (lod_ > 0) {
+        // Zoomed out: imposters, or at level 1 the full chunks still resident
+        // under one that isn't ready yet
+        const int lo = static_cast<int>(lod_);
+        for (int iy = (minChunk.y - 1) >> lo; iy <= (maxChunk.y + 1) >> lo; ++iy) {
+            for (int ix = (minChunk.x - 1) >> lo; ix <= (maxChunk.x + 1) >> lo; ++ix) {
+                if (gatherImposter(lod_, ChunkCoord{ix, iy}) || lod_ != 1) continue;
+                for (int dy = 0; dy < 2; ++dy) {
+                    for (int dx = 0; dx < 2; ++dx) {
+                        const ChunkCoord cc{ix * 2 + dx, iy * 2 + dy};
+                        if (const std::unique_ptr<Entry>* slot = chunks_.find(cc)) drawScratch_.push_back(slot->get());
+                    }
+                }
+            }
+        }
+    } else {
+        // Look up only the chunks in view (plus a one-chunk margin) instead of
+        // scanning every resident chunk, so the cost follows what is on screen.
+        // Chunks still on their way are covered by a level 1 imposter if there is one.
+        for (int cy = minChunk.y - 1; cy <= maxChunk.y + 1; ++cy) {
+            for (int cx = minChunk.x - 1; cx <= maxChunk.x + 1; ++cx) {
+                if (const std::unique_ptr<Entry>* slot = chunks_.find(ChunkCoord{cx, cy})) drawScratch_.push_back(slot->get());
+                else gatherImposter(1, ChunkCoord{cx >> 1, cy >> 1});
+            }
         }
-        
-        drawUndergroundBackgroundTiles(t, kv.second.chunk);
     }
-    
-    // Second pass: Draw tiles
-    for (auto& kv : chunks_) {
-        const ChunkCoord cc = kv.first;
-        
-        // Frustum culling: skip chunks outside view
-        if (cc.x < minChunk.x - 1 || cc.x > maxChunk.x + 1 ||
-            cc.y < minChunk.y - 1 || cc.y > maxChunk.y + 1) {
-            continue;
+}
+
+void World::prepareFrame(const sf::View& view) {
+    WET_PROFILE_SCOPE("world.prepareFrame");
+    gatherDrawList(view);
+
+    const ChunkCoord camChunk = worldPixelsToChunk(view.getCenter().x, view.getCenter().y);
+    auto distance = [&](std::int64_t cx, std::int64_t cy) {
+        const std::int64_t dx = cx - camChunk.x, dy = cy - camChunk.y;
+        return dx * dx + dy * dy;
+    };
+    prepareJobs_.clear();
+    for (Entry* e : drawScratch_) {
+        if (e->dirty()) prepareJobs_.push_back({distance(e->chunk.coord().x, e->chunk.coord().y), e, nullptr});
+    }
+    for (std::vector<ImposterBatch*>* list : {&fallbackDrawScratch_, &imposterDrawScratch_}) {
+        for (ImposterBatch* im : *list) {
+            if (!im->isDirty()) continue;
+            const std::int64_t half = (std::int64_t(1) << im->level()) / 2; // centre chunk of the cell
+            prepareJobs_.push_back({distance((std::int64_t(im->coord().x) << im->level()) + half,
+                                             (std::int64_t(im->coord().y) << im->level()) + half), nullptr, im});
         }
-        
-        Entry& entry = const_cast<Entry&>(kv.second); // Safe: only modifying batch state
-        if (entry.batch.isDirty()) {
-            entry.chunk.updateLighting(currentAmbientLight_); // Ensure lighting is up to date
-            entry.batch.build(entry.chunk, *atlas_);
+    }
+    std::sort(prepareJobs_.begin(), prepareJobs_.end(),
+              [](const PrepareJob& a, const PrepareJob& b) { return a.priority < b.priority; });
+
+    // Jobs touch nothing but their own chunk or imposter, so they can run side by side
+    const auto start = std::chrono::steady_clock::now();
+    std::atomic<size_t> ran{0};
+    const std::function<void(size_t)> job = [&](size_t i) {
+        if (i > 0 && frameBudget_.count() > 0 && std::chrono::steady_clock::now() - start >= frameBudget_) return;
+        const PrepareJob& p = prepareJobs_[i];
+        if (p.entry) {
+            refreshEntry(*p.entry);
+        } else {
+            WET_PROFILE_SCOPE("remesh.imposter");
+            p.imposter->build(*atlas_, lightShader_, currentAmbientLight_);
         }
-        t.draw(entry.batch, s);
+        ran.fetch_add(1, std::memory_order_relaxed);
+    };
+    if (workers_ && prepareJobs_.size() > 1) {
+        workers_->parallelFor(prepareJobs_.size(), job);
+    } else {
+        for (size_t i = 0; i < prepareJobs_.size(); ++i) job(i);
     }
+    deferredPrepares_ = prepareJobs_.size() - ran.load(std::memory_order_relaxed);
 }
 
-void World::drawUndergroundBackgroundTiles(sf::RenderTarget& t, const Chunk& chunk) const {
-    const auto orgTiles = chunkOriginTiles(chunk.coord());
-    const float tilePixelSize = static_cast<float>(TILE_SIZE);
-    
-    // Terrain generation parameters (same as in Chunk::generate)
-    const float mid = CHUNK_H * 0.55f;
-    const float amp = CHUNK_H * 0.18f;
-    const float wavL = 180.f;
-    const float freq = 6.28318530718f / wavL;
-    
-    for (unsigned y = 0; y < chunk.height(); ++y) {
-        for (unsigned x = 0; x < chunk.width(); ++x) {
-            TileID tile = chunk.get(x, y);
-            
-            // Only draw background behind air tiles
-            if (tile != Tile::Air) continue;
-            
-            const int worldX = orgTiles.x + static_cast<int>(x);
-            const int worldY = orgTiles.y + static_cast<int>(y);
-            
-            // Calculate terrain surface for this specific world X coordinate
-            const float surfaceY = mid + amp * std::sin(freq * static_cast<float>(worldX));
-            const int surfaceTileY = static_cast<int>(std::floor(surfaceY));
-            
-            // Only draw background if this air tile is below the surface (underground)
-            if (worldY <= surfaceTileY) continue;
-            
-            // Calculate depth-based background color
-            const int depthBelowSurface = worldY - surfaceTileY;
-            const float depthFactor = std::min(0.8f, static_cast<float>(depthBelowSurface) / 60.0f);
-            
-            const std::uint8_t r = static_cast<std::uint8_t>(25 + depthFactor * 20);
-            const std::uint8_t g = static_cast<std::uint8_t>(20 + depthFactor * 15);
-            const std::uint8_t b = static_cast<std::uint8_t>(15 + depthFactor * 10);
-            const std::uint8_t a = 255; // Fully opaque underground background
-            
-            // Draw background rectangle with integer pixel alignment to prevent bleeding
-            const int pixelX = (orgTiles.x + static_cast<int>(x)) * static_cast<int>(TILE_SIZE);
-            const int pixelY = (orgTiles.y + static_cast<int>(y)) * static_cast<int>(TILE_SIZE);
-            
-            sf::RectangleShape tileBackground(sf::Vector2f(static_cast<float>(TILE_SIZE), static_cast<float>(TILE_SIZE)));
-            tileBackground.setPosition(sf::Vector2f(static_cast<float>(pixelX), static_cast<float>(pixelY)));
-            tileBackground.setFillColor(sf::Color(r, g, b, a));
-            
-            t.draw(tileBackground);
+void World::publish(const sf::View& view, WorldSnapshot& out) {
+    WET_PROFILE_SCOPE("world.publish");
+    gatherDrawList(view);
+
+    // Same order as draw()
+    out.meshes.clear();
+    for (std::vector<ImposterBatch*>* list : {&fallbackDrawScratch_, &imposterDrawScratch_}) {
+        for (ImposterBatch* imposter : *list) imposter->publish(out.meshes);
+    }
+    for (Entry* entry : drawScratch_) entry->background.publish(out.meshes);
+    for (Entry* entry : drawScratch_) entry->batch.publish(out.meshes);
+
+    // Copies are only worth keeping for what is drawn; cached chunks drop theirs
+    ++publishCount_;
+    for (Entry* entry : drawScratch_) entry->lastPublished = publishCount_;
+    for (ChunkCoord cc : publishedChunks_) {
+        const std::unique_ptr<Entry>* slot = chunks_.find(cc);
+        if (!slot || (*slot)->lastPublished == publishCount_) continue;
+        (*slot)->batch.dropSnapshot();
+        (*slot)->background.dropSnapshot();
+    }
+    publishedChunks_.clear();
+    for (Entry* entry : drawScratch_) publishedChunks_.push_back(entry->chunk.coord());
+}
+
+void World::draw(sf::RenderTarget& t, sf::RenderStates s) const {
+    WET_PROFILE_SCOPE("world.draw");
+    gatherDrawList(t.getView());
+    lightShader_.setAmbient(static_cast<float>(currentAmbientLight_));
+    sf::RenderStates tileStates = s;
+    tileStates.shader = lightShader_.shader();
+
+    // Stand-ins first, so full chunks and exact-level imposters end up on top.
+    // Meshes are drawn as they are; prepareFrame brings them up to date.
+    {
+        WET_PROFILE_SCOPE("draw.imposters");
+        for (std::vector<ImposterBatch*>* list : {&fallbackDrawScratch_, &imposterDrawScratch_}) {
+            for (ImposterBatch* imposter : *list) t.draw(*imposter, tileStates);
         }
     }
+
+    // First pass: underground walls behind air tiles, one draw per chunk
+    {
+        WET_PROFILE_SCOPE("draw.background");
+        for (Entry* entry : drawScratch_) t.draw(entry->background, s);
+    }
+    
+    // Second pass: Draw tiles, with the time of day applied by the light shader
+    WET_PROFILE_SCOPE("draw.tiles");
+    for (Entry* entry : drawScratch_) t.draw(entry->batch, tileStates);
 }
 
 bool World::setTileAtTile(int tx, int ty, TileID id) {
+    const TileEdit edit{tx, ty, id};
+    return applyEdits(std::span<const TileEdit>(&edit, 1)) > 0;
+}
+
+World::Entry& World::residentEntry(ChunkCoord cc) {
+    if (std::unique_ptr<Entry>* slot = chunks_.find(cc)) return **slot;
+
+    cancelPending(cc); // edits can't wait for the worker
+    return insertEntry(buildEntryNow(cc));
+}
+
+size_t World::applyEdits(std::span<const TileEdit> edits) {
     assert(atlas_ && "World requires a valid TileAtlas*");
+    WET_PROFILE_SCOPE("world.applyEdits");
 
-    // Find chunk containing (tx, ty)
+    // Find chunk containing each edit
     // Use existing helpers: tile origin of chunk and CHUNK dims
     auto div_floor = [](int a, int b) {
         if (b == 0) return 0; // Handle division by zero
@@ -202,29 +751,64 @@ bool World::setTileAtTile(int tx, int ty, TileID id) {
         return q;
     };
 
-    ChunkCoord cc{div_floor(tx, (int)CHUNK_W), div_floor(ty, (int)CHUNK_H)};
-    const sf::Vector2i org = chunkOriginTiles(cc); // top-left tile of that chunk
-    const int lx = tx - org.x;
-    const int ly = ty - org.y;
-    if (lx < 0 || ly < 0 || lx >= (int)CHUNK_W || ly >= (int)CHUNK_H) return false;
+    editScratch_.clear();
+    for (size_t i = 0; i < edits.size(); ++i) {
+        const TileEdit& ed = edits[i];
+        if (ed.id > Tile::Lantern) continue; // Unknown tile type
 
-    // Get or create entry
-    auto it = chunks_.find(cc);
-    if (it == chunks_.end()) {
-        Entry e{Chunk(cc)};
-        e.chunk.generate(seed_);
-        e.chunk.updateLighting(currentAmbientLight_);
-        e.batch.build(e.chunk, *atlas_);
-        it = chunks_.emplace(cc, std::move(e)).first;
+        ChunkCoord cc{div_floor(ed.tx, (int)CHUNK_W), div_floor(ed.ty, (int)CHUNK_H)};
+        const sf::Vector2i org = chunkOriginTiles(cc); // top-left tile of that chunk
+        const int lx = ed.tx - org.x;
+        const int ly = ed.ty - org.y;
+        if (lx < 0 || ly < 0 || lx >= (int)CHUNK_W || ly >= (int)CHUNK_H) continue;
+        editScratch_.push_back({cc, static_cast<std::uint32_t>(i),
+                                static_cast<std::uint16_t>(lx), static_cast<std::uint16_t>(ly), ed.id});
     }
 
-    // Apply edit if changed
-    Entry& ent = it->second;
-    if (ent.chunk.get((unsigned)lx, (unsigned)ly) == id) return false;
-    ent.chunk.set((unsigned)lx, (unsigned)ly, id);
-    ent.chunk.updateLighting(currentAmbientLight_); // Recalculate lighting after tile change
-    ent.batch.markDirty(); // mark for rebuild instead of immediate rebuild
-    return true;
+    // Group by chunk; the original index keeps same-tile edits in order (last one wins)
+    std::sort(editScratch_.begin(), editScratch_.end(), [](const LocalEdit& a, const LocalEdit& b) {
+        if (a.cc.y != b.cc.y) return a.cc.y < b.cc.y;
+        if (a.cc.x != b.cc.x) return a.cc.x < b.cc.x;
+        return a.order < b.order;
+    });
+
+    size_t changed = 0;
+    for (size_t i = 0; i < editScratch_.size();) {
+        const ChunkCoord cc = editScratch_[i].cc;
+        Entry& ent = residentEntry(cc);
+
+        bool chunkChanged = false;
+        for (; i < editScratch_.size() && editScratch_[i].cc == cc; ++i) {
+            const LocalEdit& ed = editScratch_[i];
+            const TileID old = ent.chunk.get(ed.lx, ed.ly);
+            if (old == ed.id) continue;
+            if (ent.generatedTiles.empty()) {
+                // First edit of a generated chunk: its tiles are still the generator's
+                ent.generatedTiles.resize(CHUNK_TILES);
+                ent.chunk.copyTiles(ent.generatedTiles.data());
+            }
+            const TileID generated = ent.generatedTiles[chunkTileIndex(ed.lx, ed.ly)];
+            if (old == generated) ++ent.differingTiles;
+            else if (ed.id == generated) --ent.differingTiles;
+            ent.chunk.set(ed.lx, ed.ly, ed.id);
+            if ((old == Tile::Air) != (ed.id == Tile::Air)) ent.background.markDirty();
+            chunkChanged = true;
+            ++changed;
+
+            ent.batch.markDirty(ed.lx, ed.ly, ed.lx, ed.ly);
+            light_.tileChanged(cc.x * static_cast<int>(CHUNK_W) + ed.lx, cc.y * static_cast<int>(CHUNK_H) + ed.ly);
+        }
+
+        // Remeshed by the next frame's jobs, only over the edited rectangle
+        if (chunkChanged) {
+            ent.modified = true;
+            ent.chunk.markLightingCurrent(); // kept current above instead of a full relight
+        }
+    }
+
+    // Light around all changed tiles at once; the tiles it reaches are remeshed too
+    flushLight();
+    return changed;
 }
 
 bool World::setTileAtPixel(const sf::Vector2f& worldPx, TileID id) {
@@ -245,13 +829,16 @@ bool World::setTileAtPixel(const sf::Vector2f& worldPx, TileID id) {
 
 void World::updateAmbientLight(unsigned ambientLevel) {
     if (ambientLevel == currentAmbientLight_) return; // No change needed
+    WET_PROFILE_SCOPE("world.updateAmbientLight");
     
     currentAmbientLight_ = ambientLevel;
-    
-    // Force immediate lighting recalculation for ALL chunks
-    for (auto& kv : chunks_) {
-        Entry& entry = kv.second;
-        entry.chunk.updateLighting(currentAmbientLight_);
-        entry.batch.markDirty(); // Mark batch for rebuild with new lighting
+
+    // Sky exposure doesn't depend on the time of day, so nothing is relit. The
+    // uniform is left to draw(), which keeps GL calls on the drawing thread.
+    if (lightShader_.active()) return;
+    // Baked meshes: rebuilt by the frame jobs over the next frames, nearest first
+    chunks_.forEach([&](ChunkCoord, std::unique_ptr<Entry>& e) { e->batch.markDirty(); });
+    for (auto& level : imposters_) {
+        level.forEach([&](ChunkCoord, std::unique_ptr<Imposter>& im) { im->batch.markDirty(); });
     }
-}
\ No newline at end of file
+}
@@ -1,44 +1,358 @@
 #pragma once
-#include <unordered_map>
 #include <vector>
+#include <span>
+#include <memory>
+#include <mutex>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <filesystem>
 #include <stdexcept>
 #include <SFML/Graphics.hpp>
 #include "engine/tile/Coords.hpp"
 #include "engine/tile/Chunk.hpp"
 #include "engine/tile/TileBatch.hpp"
+#include "engine/tile/BackgroundBatch.hpp"
+#include "engine/tile/ImposterBatch.hpp"
 #include "engine/tile/TileAtlas.hpp"
 #include "engine/tile/TileTypes.hpp"
+#include "engine/world/WorkerPool.hpp"
+#include "engine/world/RegionStore.hpp"
+#include "engine/world/ChunkTable.hpp"
+#include "engine/world/TileEdits.hpp"
+#include "engine/world/LightEngine.hpp"
+#include "engine/world/SurfaceCache.hpp"
+#include "engine/world/WorldSnapshot.hpp"
+
+// Camera motion used to predict where chunks will be needed
+struct ViewMotion {
+    sf::Vector2f velocity{0.f, 0.f}; // pixels/second
+    float zoomRate = 0.f;            // d(ln viewSize)/dt, positive while zooming out
+    float lookaheadSeconds = 0.5f;   // how far ahead to prefetch
+};
 
 class World : public sf::Drawable {
 public:
-    explicit World(const TileAtlas* atlas, unsigned seed = 0, size_t maxChunks = 1000)
-        : atlas_(atlas), seed_(seed), maxChunks_(maxChunks) {
+    // Chunks that became visible this session, split by whether they were resident in time
+    struct PrefetchStats {
+        std::uint64_t readyOnArrival = 0;
+        std::uint64_t missedOnArrival = 0;
+    };
+
+    // Heap traffic of the chunk pipeline; steady-state panning should leave the
+    // allocation counters flat while reuses keep climbing
+    struct PoolStats {
+        std::uint64_t entryAllocations = 0;    // fresh Entry: tiles, light map, vertex buffer
+        std::uint64_t entryReuses = 0;         // Entry taken from the free list
+        std::uint64_t vertexBufferGrowths = 0; // meshing outgrew a recycled vertex buffer
+        std::uint64_t jobAllocations = 0;      // fresh background job record
+        size_t pooledEntries = 0;
+    };
+
+    static constexpr size_t DEFAULT_MEMORY_BUDGET = size_t(512) << 20; // bytes
+
+    // memoryBudgetBytes: soft cap on tiles + light + vertices kept for off-screen chunks
+    // workerThreads: chunk generation threads; 0 generates inline on the caller
+    explicit World(const TileAtlas* atlas, unsigned seed = 0,
+                   size_t memoryBudgetBytes = DEFAULT_MEMORY_BUDGET,
+                   unsigned workerThreads = WorkerPool::defaultThreadCount())
+        : atlas_(atlas), seed_(seed), memoryBudget_(memoryBudgetBytes) {
         if (!atlas_) {
             throw std::invalid_argument("World requires a valid TileAtlas pointer");
         }
+        if (workerThreads > 0) {
+            workers_ = std::make_unique<WorkerPool>(workerThreads);
+        }
     }
+    ~World() override;
+
+    World(const World&) = delete;
+    World& operator=(const World&) = delete;
 
-    // keepMarginChunks: extra chunk margin to keep around visible area
+    // Chunks within the view + inflatePixels are loaded (load range).
+    // keepMarginChunks: extra chunk margin around the load range before a chunk is
+    // unloaded (unload range). Chunks between the two stay cached until the memory
+    // budget needs their space, least recently visible first.
     void ensureVisible(const sf::View& view,
                        float inflatePixels = 256.f,
                        int keepMarginChunks = 2);
+    // Same, but the load range also covers where the view is heading
+    void ensureVisible(const sf::View& view, const ViewMotion& motion,
+                       float inflatePixels = 256.f,
+                       int keepMarginChunks = 2);
 
     // NEW: edit helpers
     bool setTileAtTile(int tx, int ty, TileID id);
     bool setTileAtPixel(const sf::Vector2f& worldPx, TileID id);
+
+    // Apply many edits at once (see TileEdits:: for shapes). Edits are grouped by
+    // chunk; light is updated incrementally around the changed tiles (across chunk
+    // borders) and every chunk whose tiles or light changed is remeshed once.
+    // Returns tiles changed.
+    size_t applyEdits(std::span<const TileEdit> edits);
     
-    // Lighting update
+    // Time of day. Light maps don't depend on it; with shader support it is a
+    // uniform set at the next draw, otherwise resident meshes are rebuilt over the
+    // next frames within the frame budget.
     void updateAmbientLight(unsigned ambientLevel);
+    bool shaderLighting() const { return lightShader_.active(); }
+
+    // Persistence: edited chunks are written to region files in dir when they are
+    // evicted and on destruction, and read back instead of regenerating them. Only
+    // chunks that differ from the generator are kept; one edited back to its
+    // generated tiles has its saved copy removed instead. A
+    // chunk whose write fails is never dropped: it stays resident and is retried on
+    // later evictions and saves. Failures left at destruction go to stderr.
+    // Throws std::runtime_error if dir can't be created; the previous setting stays.
+    void setSaveDirectory(const std::filesystem::path& dir);
+    struct SaveResult {
+        size_t written = 0; // stored, or their saved copy dropped as matching the generator
+        size_t failed = 0;
+    };
+    SaveResult saveModifiedChunks();
+    // Edited chunks whose last write failed, held in memory until one succeeds
+    size_t unsavedChunkCount() const { return unsavedChunks_; }
+
+    size_t loadedChunkCount()  const { return chunks_.size(); }
+    size_t pendingChunkCount() const { return pending_.size(); }
+    size_t residentBytes()     const { return residentBytes_; }
+    size_t surfaceColumnCount() const { return surfaces_.size(); }
+    size_t memoryBudget()      const { return memoryBudget_; }
+    void   setMemoryBudget(size_t bytes) { memoryBudget_ = bytes; }
+
+    // Level of detail. Zoomed out far enough that a tile covers less than
+    // MIN_CELL_PIXELS screen pixels, the world is drawn with imposters (see
+    // ImposterBatch) made straight from the terrain functions, and no new full
+    // chunks are loaded.
+    static constexpr unsigned MAX_LOD_LEVEL = 10;
+    static constexpr float MIN_CELL_PIXELS = 4.f;
+    // Window size in pixels; with the view size it gives screen pixels per tile
+    void setScreenSize(sf::Vector2u size) { if (size.x > 0 && size.y > 0) screenSize_ = size; }
+    // 0 = full chunks, k = imposters with 2^k x 2^k tiles per cell
+    unsigned lodLevelFor(const sf::View& view) const;
+    unsigned lodLevel() const { return lod_; }
+    size_t imposterCount() const;
+
+    const PrefetchStats& prefetchStats() const { return prefetchStats_; }
+    void resetPrefetchStats() { prefetchStats_ = {}; }
+
+    PoolStats poolStats() const;
+
+    // Bring everything drawn in view up to date: dirty chunks are relit and
+    // remeshed, and dirty imposters remeshed, nearest first and in parallel on the
+    // worker threads and this one. Call once per frame between ensureVisible and
+    // drawing; draw() only submits meshes and shows the previous one of anything
+    // still dirty.
+    void prepareFrame(const sf::View& view);
+
+    // Fill out with what draw() would submit for view, for another thread to draw
+    // while this one carries on; call after prepareFrame. Each
+    // mesh is copied the first time it is published after a change; unchanged ones
+    // share the previous copy. Chunks that leave the draw list drop theirs.
+    void publish(const sf::View& view, WorldSnapshot& out);
+
+    // Main-thread chunk work is spread over frames. ensureVisible queues generation
+    // (when there are no workers) and refreshes of dirty chunks outside the view,
+    // on-screen before prefetch, each nearest first; prepareFrame handles what is
+    // in view. Each stops starting jobs once the frame budget has passed since it
+    // began and leaves the rest for the next frame; at least one job runs per call.
+    // A zero budget runs everything at once.
+    static constexpr std::chrono::microseconds DEFAULT_FRAME_BUDGET{2000};
+    void setFrameBudget(std::chrono::microseconds budget) { frameBudget_ = budget; }
+    std::chrono::microseconds frameBudget() const { return frameBudget_; }
+    size_t deferredJobCount() const { return deferredJobs_ + deferredPrepares_; } // left over by the last frame
 
 private:
-    struct Entry { Chunk chunk; TileBatch batch; };
+    struct Entry {
+        explicit Entry(ChunkCoord cc) : chunk(cc) {}
+        // Prepare a recycled entry for another chunk; buffers keep their capacity.
+        // Runs on workers, so the surface reference is left to the owner thread.
+        void reset(ChunkCoord cc) {
+            chunk.reset(cc);
+            batch.clear();
+            background.clear();
+            modified = false;
+            lruPrev = lruNext = nullptr;
+            lastTouched = 0;
+            lastPublished = 0;
+            nextSaveAttempt = 0;
+            generatedTiles.clear();
+            differingTiles = 0;
+            bytes = 0;
+        }
+
+        // Lighting or a mesh is out of date
+        bool dirty() const { return chunk.isLightingDirty() || batch.isDirty() || background.isDirty(); }
 
-    std::unordered_map<ChunkCoord, Entry, ChunkCoordHash> chunks_;
+        size_t memoryBytes() const {
+            return chunk.memoryBytes() + batch.memoryBytes() + background.memoryBytes() +
+                   generatedTiles.capacity() * sizeof(TileID);
+        }
+
+        Chunk chunk;
+        TileBatch batch;
+        BackgroundBatch background; // cave walls behind the tiles
+        SurfaceCache::StripRef surface; // this chunk column's terrain surface
+        bool modified = false; // edited since generation or the last save
+
+        // The tiles as generated, kept once the chunk is edited or loaded from disk
+        // (empty while it is untouched), and how many tiles now differ from them.
+        // At zero the chunk needs no saved copy.
+        std::vector<TileID> generatedTiles;
+        size_t differingTiles = 0;
+
+        // Intrusive LRU links (entries are heap-pinned), most recently visible first
+        Entry* lruPrev = nullptr;
+        Entry* lruNext = nullptr;
+        std::uint64_t lastTouched = 0;   // frame this chunk was last in the load range
+        std::uint64_t lastPublished = 0; // publish() call that last included it
+        size_t bytes = 0;                // accounted resident size
+        std::uint64_t nextSaveAttempt = 0; // after a failed save: frame to retry from on eviction
+    };
+
+    // One background generation. Jobs are recycled: the worker always hands the job
+    // back through done_, cancelled or not, so its entry returns to the pool.
+    struct ChunkJob {
+        ChunkCoord coord{};
+        unsigned ambient = 0;
+        std::array<std::uint8_t, CHUNK_W> skyAbove{}; // sky seeds from the heightmap at request time
+        std::atomic<bool> cancelled{false};
+        std::unique_ptr<Entry> entry; // being built by the worker
+    };
+
+    // LOD imposter and its background job, recycled like ChunkJob
+    struct Imposter {
+        ImposterBatch batch;
+        std::uint64_t lastTouched = 0; // frame it was last in the load range
+    };
+    struct ImposterJob {
+        ChunkCoord coord{}; // chunk coordinate >> level
+        unsigned level = 0;
+        unsigned ambient = 0;
+        std::atomic<bool> cancelled{false};
+        std::unique_ptr<Imposter> imposter;
+    };
+    static constexpr std::uint64_t IMPOSTER_KEEP_FRAMES = 120; // unused imposters go after this
+
+    // Entries are heap-pinned: workers fill them in place and the LRU links point at them
+    ChunkTable<std::unique_ptr<Entry>> chunks_;
     const TileAtlas* atlas_{nullptr};
     unsigned seed_{0};
-    size_t maxChunks_{1000};
+    size_t memoryBudget_{DEFAULT_MEMORY_BUDGET};
     unsigned currentAmbientLight_{12}; // Current ambient light level
+    mutable LightShader lightShader_;  // applies the ambient level at draw time; only draw() sets it
+    std::unique_ptr<RegionStore> regions_; // null when persistence is off
+    static constexpr std::uint64_t SAVE_RETRY_FRAMES = 120; // between eviction attempts of an unsaved chunk
+    size_t unsavedChunks_ = 0;
+    SurfaceCache surfaces_;                // per chunk column, shared by the chunks stacked in it
+
+    // Sky heightmap and block light across chunk borders; resolves chunks through chunks_
+    static Chunk* lightLookup(void* world, ChunkCoord cc);
+    LightEngine light_{&World::lightLookup, this};
+
+    // LRU cache bookkeeping
+    Entry* lruHead_ = nullptr;
+    Entry* lruTail_ = nullptr;
+    size_t residentBytes_ = 0;
+    std::uint64_t frame_ = 0;
+
+    // Prefetch effectiveness: on-screen chunk range of the previous frame
+    PrefetchStats prefetchStats_;
+    ChunkCoord visibleMin_{}, visibleMax_{};
+    bool hasVisible_ = false;
+
+    // Background generation: jobs in flight and finished jobs awaiting pickup
+    ChunkTable<ChunkJob*> pending_;
+    std::vector<ChunkCoord> cancelScratch_;
+
+    // applyEdits scratch: edits resolved to chunk-local coordinates
+    struct LocalEdit {
+        ChunkCoord cc;
+        std::uint32_t order;
+        std::uint16_t lx, ly;
+        TileID id;
+    };
+    std::vector<LocalEdit> editScratch_;
+    std::mutex doneMutex_;
+    std::vector<ChunkJob*> done_;
+    std::vector<ChunkJob*> doneScratch_;
+
+    // Recycling: retired entries and job records are reused instead of freed
+    static constexpr size_t MAX_POOLED_ENTRIES = 32;
+    std::vector<std::unique_ptr<Entry>>    freeEntries_;
+    std::vector<std::unique_ptr<ChunkJob>> jobs_; // owns every job ever created
+    std::vector<ChunkJob*>                 freeJobs_;
+    PoolStats poolStats_;
+    mutable std::atomic<std::uint64_t> vertexBufferGrowths_{0}; // bumped by workers
+
+    mutable std::vector<Entry*> drawScratch_; // chunks in view this frame
+
+    // Budgeted main-thread work, rebuilt by every ensureVisible from what is still
+    // missing or dirty in the load range, so nothing goes stale between frames
+    struct FrameJob {
+        enum class Kind : std::uint8_t { BuildChunk, RefreshChunk, BuildImposter };
+        std::int64_t priority; // squared distance in chunks (imposter cells), + PREFETCH_PRIORITY off screen
+        Kind kind;
+        unsigned level;        // imposters only
+        ChunkCoord coord;      // chunk, or imposter cell at level
+    };
+    static constexpr std::int64_t PREFETCH_PRIORITY = std::int64_t(1) << 40;
+    std::chrono::microseconds frameBudget_{DEFAULT_FRAME_BUDGET};
+    std::vector<FrameJob> frameJobs_;
+    size_t deferredJobs_ = 0;
+
+    // prepareFrame: dirty chunk or imposter in the draw list, one of the two set
+    struct PrepareJob {
+        std::int64_t priority; // squared distance in chunks from the view centre
+        Entry* entry;
+        ImposterBatch* imposter;
+    };
+    std::vector<PrepareJob> prepareJobs_;
+    size_t deferredPrepares_ = 0;
+
+    // publish(): chunks in the last snapshot, so those that leave it drop their copies
+    std::uint64_t publishCount_ = 0;
+    std::vector<ChunkCoord> publishedChunks_;
+
+    // Imposters per level (index 0 unused), keyed by chunk coordinate >> level
+    std::array<ChunkTable<std::unique_ptr<Imposter>>, MAX_LOD_LEVEL + 1> imposters_;
+    std::array<ChunkTable<ImposterJob*>, MAX_LOD_LEVEL + 1> pendingImposters_;
+    std::vector<std::unique_ptr<ImposterJob>> imposterJobs_; // owns every imposter job
+    std::vector<ImposterJob*> freeImposterJobs_;
+    std::vector<ImposterJob*> doneImposters_;       // guarded by doneMutex_
+    std::vector<ImposterJob*> doneImpostersScratch_;
+    std::vector<std::pair<unsigned, ChunkCoord>> imposterScratch_;
+    mutable std::vector<ImposterBatch*> fallbackDrawScratch_, imposterDrawScratch_;
+    sf::Vector2u screenSize_{1280u, 720u};
+    unsigned lod_ = 0;
+
+    std::unique_ptr<Entry> acquireEntry(ChunkCoord cc);
+    void releaseEntry(std::unique_ptr<Entry> e);
+    void fillEntry(Entry& e, ChunkCoord cc, unsigned ambient, const std::uint8_t* skyAbove) const;
+    std::unique_ptr<Entry> buildEntryNow(ChunkCoord cc); // generate and light on this thread
+    void requestChunk(ChunkCoord cc, std::int64_t priority);
+    void requestImposter(unsigned level, ChunkCoord ic, std::int64_t priority);
+    void collectFinishedImposters();
+    void updateImposters(ChunkCoord cmin, ChunkCoord cmax, ChunkCoord camChunk);
+    // Draw-time lookup; a missing imposter falls back to the next coarser or finer
+    // level. Returns false if nothing covers ic.
+    bool gatherImposter(unsigned level, ChunkCoord ic) const;
+    void collectFinishedChunks();
+    void cancelPending(ChunkCoord cc);
+    bool saveIfModified(Entry& e); // false if an edit is still unsaved
+    Entry& residentEntry(ChunkCoord cc); // generates inline if needed
+    Entry& insertEntry(std::unique_ptr<Entry> e);
+    void touch(Entry& e);
+    void evict(ChunkCoord cc); // keeps chunks whose edits can't be saved
+    void countArrivals(ChunkCoord vmin, ChunkCoord vmax);
+    void flushLight(); // run queued light updates and mark the chunks they reached for remeshing
+    void runFrameJobs();
+    void runFrameJob(const FrameJob& job);
+    void refreshEntry(Entry& e); // relight and remesh whatever is dirty; safe on workers
+    void gatherDrawList(const sf::View& view) const; // fills the draw scratch lists
 
     void draw(sf::RenderTarget& t, sf::RenderStates s) const override;
-    void drawUndergroundBackgroundTiles(sf::RenderTarget& t, const Chunk& chunk) const;
+
+    // Declared last so the threads are joined before anything they touch is destroyed
+    std::unique_ptr<WorkerPool> workers_;
 };
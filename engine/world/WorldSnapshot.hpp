@@ -0,0 +1,16 @@
+#pragma once
+#include <SFML/Graphics.hpp>
+#include <vector>
+#include "engine/tile/MeshSnapshot.hpp"
+
+// What World::draw would submit for a view, as shared read-only meshes (see
+// World::publish). Drawing it doesn't touch the world, so it can run on one
+// thread while another edits, relights and remeshes.
+struct WorldSnapshot {
+    std::vector<MeshHandle> meshes; // in draw order
+
+    // lightShader: applies the time of day to lit meshes, as in World::draw
+    void draw(sf::RenderTarget& t, sf::RenderStates s, const sf::Shader* lightShader) const {
+        for (const MeshHandle& mesh : meshes) mesh->draw(t, s, lightShader);
+    }
+};
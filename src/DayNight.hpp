@@ -0,0 +1,81 @@
+#pragma once
+#include <SFML/Graphics.hpp>
+#include <cmath>
+#include <cstdint>
+
+// Day/night cycle as functions of game time, shared by the simulation (which sets
+// the world's ambient level) and the render thread (which interpolates between ticks)
+namespace DayNight {
+
+inline constexpr float DAY_LENGTH = 52.f; // Day/night cycle duration in real seconds (30% longer)
+
+// 0.0 to 1.0 through the cycle
+inline float progress(double gameTime) {
+    return static_cast<float>(std::fmod(gameTime / DAY_LENGTH, 1.0));
+}
+
+// Calculate ambient light based on time of day, fractional through dawn and dusk
+// 0.0-0.15 = night, 0.15-0.35 = dawn, 0.35-0.65 = day, 0.65-0.85 = dusk, 0.85-1.0 = night
+inline float ambient(float dayProgress) {
+    if (dayProgress < 0.15f) {
+        // Night
+        return 2.f; // Dark
+    } else if (dayProgress < 0.35f) {
+        // Dawn - longer gradual brightening
+        float t = (dayProgress - 0.15f) / 0.2f; // 0.2 duration for smooth transition
+        return 2.f + t * 10.f; // 2 to 12
+    } else if (dayProgress < 0.65f) {
+        // Full day - longer daylight period
+        return 12.f; // Full daylight
+    } else if (dayProgress < 0.85f) {
+        // Dusk - longer gradual dimming
+        float t = (dayProgress - 0.65f) / 0.2f; // 0.2 duration for smooth transition
+        return 12.f - t * 10.f; // 12 to 2
+    }
+    // Night
+    return 2.f; // Dark
+}
+
+// Calculate sky color based on time of day with smooth long gradients
+inline sf::Color skyColor(float dayProgress) {
+    if (dayProgress < 0.15f) {
+        // Night - dark purple/blue
+        return sf::Color(15, 8, 35);
+    } else if (dayProgress < 0.35f) {
+        // Dawn - longer dark to purple/pink gradient
+        float t = (dayProgress - 0.15f) / 0.2f; // Smoother over longer period
+        return sf::Color(
+            static_cast<std::uint8_t>(15 + t * 105),   // 15 to 120 (purple)
+            static_cast<std::uint8_t>(8 + t * 62),     // 8 to 70   (purple tones)
+            static_cast<std::uint8_t>(35 + t * 145)    // 35 to 180 (brighter)
+        );
+    } else if (dayProgress < 0.5f) {
+        // Early day - transition from dawn purple to blue
+        float t = (dayProgress - 0.35f) / 0.15f; // Longer transition
+        return sf::Color(
+            static_cast<std::uint8_t>(120 - t * 35),   // 120 to 85
+            static_cast<std::uint8_t>(70 + t * 100),   // 70 to 170
+            static_cast<std::uint8_t>(180 + t * 55)    // 180 to 235
+        );
+    } else if (dayProgress < 0.65f) {
+        // Full day - cute blue
+        return sf::Color(85, 170, 235);
+    } else if (dayProgress < 0.85f) {
+        // Dusk - longer blue to warm orange gradient
+        float t = (dayProgress - 0.65f) / 0.2f; // Longer smooth transition
+        return sf::Color(
+            static_cast<std::uint8_t>(85 + t * 145),    // 85 to 230  (warm orange)
+            static_cast<std::uint8_t>(170 - t * 70),    // 170 to 100 (orange tone)
+            static_cast<std::uint8_t>(235 - t * 195)    // 235 to 40  (less blue)
+        );
+    }
+    // Night transition - longer orange to dark
+    float t = (dayProgress - 0.85f) / 0.15f; // Smoother transition to night
+    return sf::Color(
+        static_cast<std::uint8_t>(230 - t * 215),   // 230 to 15  (orange to dark)
+        static_cast<std::uint8_t>(100 - t * 92),    // 100 to 8   (dim to dark)
+        static_cast<std::uint8_t>(40 - t * 5)       // 40 to 35   (keep some purple)
+    );
+}
+
+} // namespace DayNight
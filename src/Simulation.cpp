@@ -0,0 +1,120 @@
+#include "Simulation.hpp"
+#include "DayNight.hpp"
+#include "engine/profile/Profiler.hpp"
+#include <cmath>
+
+Simulation::Simulation(World& world) : world_(world) {
+    world_.setFrameBudget(WORK_BUDGET);
+    thread_ = std::thread([this] { run(); });
+}
+
+Simulation::~Simulation() {
+    running_.store(false, std::memory_order_relaxed);
+    thread_.join();
+}
+
+void Simulation::setCamera(const sf::View& view, const ViewMotion& motion) {
+    Input input;
+    input.kind = Input::Kind::Camera;
+    input.view = view;
+    input.motion = motion;
+    post(input);
+}
+
+void Simulation::setScreenSize(sf::Vector2u size) {
+    Input input;
+    input.kind = Input::Kind::ScreenSize;
+    input.size = size;
+    post(input);
+}
+
+void Simulation::edit(sf::Vector2f worldPos, TileID id, bool brush) {
+    Input input;
+    input.kind = Input::Kind::Edit;
+    input.worldPos = worldPos;
+    input.id = id;
+    input.brush = brush;
+    post(input);
+}
+
+void Simulation::post(const Input& input) {
+    std::lock_guard<std::mutex> lock(inputMutex_);
+    input_.push_back(input);
+}
+
+void Simulation::run() {
+    WET_PROFILE_THREAD("sim");
+    using Clock = std::chrono::steady_clock;
+    const auto period = std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(1.0 / TICK_RATE));
+
+    auto next = Clock::now();
+    while (running_.load(std::memory_order_relaxed)) {
+        tick();
+        // Late ticks run back to back until caught up; past MAX_CATCH_UP_TICKS the
+        // backlog is dropped (game time slows down) rather than snowballing
+        next += period;
+        const auto now = Clock::now();
+        if (now - next > period * MAX_CATCH_UP_TICKS) next = now;
+        std::this_thread::sleep_until(next);
+    }
+}
+
+void Simulation::tick() {
+    WET_PROFILE_SCOPE("sim.tick");
+    const auto start = std::chrono::steady_clock::now();
+
+    {
+        std::lock_guard<std::mutex> lock(inputMutex_);
+        inputScratch_.swap(input_);
+    }
+    for (const Input& in : inputScratch_) {
+        switch (in.kind) {
+        case Input::Kind::Camera:
+            view_ = in.view;
+            motion_ = in.motion;
+            hasView_ = true;
+            break;
+        case Input::Kind::ScreenSize:
+            world_.setScreenSize(in.size); // picks the level of detail when zoomed out
+            break;
+        case Input::Kind::Edit:
+            if (in.brush) {
+                const int tx = static_cast<int>(std::floor(in.worldPos.x / static_cast<float>(TILE_SIZE)));
+                const int ty = static_cast<int>(std::floor(in.worldPos.y / static_cast<float>(TILE_SIZE)));
+                brush_.clear();
+                TileEdits::circle(brush_, tx, ty, /*radius=*/3, in.id);
+                world_.applyEdits(brush_);
+            } else {
+                world_.setTileAtPixel(in.worldPos, in.id); // dig / place selected tile
+            }
+            break;
+        }
+    }
+    inputScratch_.clear();
+
+    // Day/night cycle: baked meshes are rebuilt when the level steps; with the light
+    // shader the render thread blends the level itself
+    gameTime_ += 1.0 / TICK_RATE;
+    world_.updateAmbientLight(static_cast<unsigned>(DayNight::ambient(DayNight::progress(gameTime_))));
+
+    SimSnapshot& out = snapshots_.back();
+    if (hasView_) {
+        // Lazy-load visible chunks around the camera
+        world_.ensureVisible(view_, motion_, /*inflatePixels=*/TILE_SIZE * 8.f, /*keepMarginChunks=*/2);
+        // Relight and remesh what is about to be drawn, across all cores
+        world_.prepareFrame(view_);
+        // The draw list keeps a chunk of margin around the view, which covers the
+        // camera moving on between this tick and the frames that draw it
+        world_.publish(view_, out.world);
+    } else {
+        out.world.meshes.clear();
+    }
+    out.tick = ++tick_;
+    out.gameTime = gameTime_;
+    out.prefetch = world_.prefetchStats();
+    out.lod = world_.lodLevel();
+    out.deferredJobs = world_.deferredJobCount();
+    out.unsavedChunks = world_.unsavedChunkCount();
+    out.tickMs = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - start).count();
+    snapshots_.publish();
+}
@@ -0,0 +1,93 @@
+#pragma once
+#include <SFML/Graphics.hpp>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "engine/tile/TileTypes.hpp"
+#include "engine/world/SnapshotBuffer.hpp"
+#include "engine/world/TileEdits.hpp"
+#include "engine/world/World.hpp"
+#include "engine/world/WorldSnapshot.hpp"
+
+// One tick as the render thread sees it. Published whole and never changed after.
+struct SimSnapshot {
+    std::uint64_t tick = 0; // 0 until the first tick
+    double gameTime = 0.0;  // seconds, at the end of the tick
+    WorldSnapshot world;    // meshes around the camera view the tick used
+
+    // HUD figures
+    World::PrefetchStats prefetch;
+    unsigned lod = 0;
+    size_t deferredJobs = 0;
+    size_t unsavedChunks = 0; // edits the save directory refused
+    float tickMs = 0.f;
+};
+
+// Runs the world on its own thread at a fixed tick rate: edits, chunk loading,
+// lighting, remeshing and the time of day, so their cost no longer comes out of
+// the frame rate. Nothing else may touch the world while a Simulation runs it:
+// input goes in through the queued calls below and every tick publishes a
+// snapshot to draw.
+class Simulation {
+public:
+    static constexpr double TICK_RATE = 60.0;  // ticks per second
+    static constexpr int MAX_CATCH_UP_TICKS = 5; // further behind, the backlog is dropped
+    // Chunk work per tick for each of ensureVisible and prepareFrame; with drawing
+    // off this thread it can take a good part of the tick
+    static constexpr std::chrono::microseconds WORK_BUDGET{6000};
+
+    // Starts ticking at once
+    explicit Simulation(World& world);
+    ~Simulation(); // stops and joins the thread
+
+    Simulation(const Simulation&) = delete;
+    Simulation& operator=(const Simulation&) = delete;
+
+    // Queued for the next tick; any thread
+    void setCamera(const sf::View& view, const ViewMotion& motion);
+    void setScreenSize(sf::Vector2u size);
+    void edit(sf::Vector2f worldPos, TileID id, bool brush); // brush: a disc instead of one tile
+
+    // Render thread: take the newest tick, if there is one it hasn't seen; returns
+    // whether snapshot() changed. snapshot() stays valid until the next acquire().
+    bool acquire() { return snapshots_.acquire(); }
+    const SimSnapshot& snapshot() const { return snapshots_.front(); }
+
+private:
+    struct Input {
+        enum class Kind : std::uint8_t { Camera, ScreenSize, Edit };
+        Kind kind = Kind::Camera;
+        sf::View view;           // Camera
+        ViewMotion motion;       // Camera
+        sf::Vector2u size;       // ScreenSize
+        sf::Vector2f worldPos;   // Edit, in world pixels
+        TileID id = Tile::Air;   // Edit
+        bool brush = false;      // Edit
+    };
+
+    void post(const Input& input);
+    void run();
+    void tick();
+
+    World& world_;
+
+    // Simulation thread only
+    double gameTime_ = 0.0;
+    std::uint64_t tick_ = 0;
+    sf::View view_;
+    ViewMotion motion_;
+    bool hasView_ = false; // nothing is loaded before the first camera update
+    std::vector<TileEdit> brush_;
+    std::vector<Input> inputScratch_;
+
+    std::mutex inputMutex_;
+    std::vector<Input> input_; // guarded by inputMutex_
+
+    SnapshotBuffer<SimSnapshot> snapshots_;
+    std::atomic<bool> running_{true};
+    std::thread thread_; // declared last: started once everything above exists
+};
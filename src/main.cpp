@@ -1,14 +1,22 @@
 #include <SFML/Graphics.hpp>
 #include <SFML/Window.hpp>
+#include <algorithm>
 #include <cstdio>
+#include <ctime>
+#include <exception>
 #include <vector>
 #include <string>
 
 #include "engine/render/Camera.hpp"
+#include "engine/render/ProfilerOverlay.hpp"
 #include "engine/world/World.hpp"
+#include "engine/tile/LightShader.hpp"
 #include "engine/tile/TileAtlas.hpp"
+#include "DayNight.hpp"
+#include "Simulation.hpp"
 
 int main() {
+    WET_PROFILE_THREAD("main");
     const sf::String title("WetTerrarium - textured world");
     sf::RenderWindow window(sf::VideoMode({1280u, 720u}), title);
     window.setFramerateLimit(144);
@@ -21,7 +29,16 @@ int main() {
     // Tiles/World
     TileAtlas atlas(TILE_SIZE);
     World world(&atlas, /*seed=*/0);
+    world.setScreenSize(window.getSize()); // picks the level of detail when zoomed out
+    try {
+        world.setSaveDirectory("saves/seed-0"); // edited chunks survive eviction and restarts
+    } catch (const std::exception& e) {
+        // e.g. a read-only working directory: play on, edits just aren't kept
+        std::fprintf(stderr, "Saving disabled: %s\n", e.what());
+    }
+    LightShader light; // applies the time of day to the published meshes; the world's own stays with it
     TileID selectedTile = Tile::Stone; // Default selected tile
+    bool brushHeld = false;            // Shift: edit a disc instead of one tile
 
     // HUD
     sf::Font font;
@@ -48,21 +65,31 @@ int main() {
         fpsText.setFillColor(sf::Color::White);
         fpsText.setPosition({8.f, 8.f});
     }
+#if WET_PROFILE
+    // F3: per-section timings and frame graph; F4: last seconds as a Chrome trace
+    ProfilerOverlay profilerOverlay(font);
+    profilerOverlay.setPosition({8.f, 112.f}); // below the stats text
+    constexpr double TRACE_SECONDS = 5.0;
+#endif
 
     sf::Clock frameClock;
     float accum = 0.f; int frames = 0;
-    
-    // Day/night cycle
-    float gameTime = 0.f;                // Game time in seconds
-    const float dayLength = 52.f;        // Day/night cycle duration in real seconds (30% longer)
-    unsigned currentAmbientLight = 12;   // Current ambient light level
+
+    // From here on the world belongs to the simulation thread: input is queued to
+    // it and each frame draws the latest tick it published
+    Simulation sim(world);
+    double prevGameTime = 0.0, tickGameTime = 0.0; // last two ticks taken
+    sf::Clock tickClock;                           // since the last one arrived
 
     while (window.isOpen()) {
         while (auto ev = window.pollEvent()) {
             if (ev->is<sf::Event::Closed>()) {
                 window.close();
+            } else if (const auto* resized = ev->getIf<sf::Event::Resized>()) {
+                sim.setScreenSize(resized->size);
             } else if (const auto* key = ev->getIf<sf::Event::KeyPressed>()) {
                 if (key->scancode == sf::Keyboard::Scan::Escape) window.close();
+                if (key->scancode == sf::Keyboard::Scan::LShift || key->scancode == sf::Keyboard::Scan::RShift) brushHeld = true;
                 
                 // Handle tile selection keys
                 if (key->scancode == sf::Keyboard::Scan::Num1) selectedTile = Tile::Stone;
@@ -71,6 +98,17 @@ int main() {
                 else if (key->scancode == sf::Keyboard::Scan::Num4) selectedTile = Tile::Wood;
                 else if (key->scancode == sf::Keyboard::Scan::Num5) selectedTile = Tile::Torch;
                 else if (key->scancode == sf::Keyboard::Scan::Num6) selectedTile = Tile::Lantern;
+#if WET_PROFILE
+                if (key->scancode == sf::Keyboard::Scan::F3) profilerOverlay.toggle();
+                if (key->scancode == sf::Keyboard::Scan::F4) {
+                    const std::string path = "profile-" + std::to_string(std::time(nullptr)) + ".json";
+                    if (Profiler::writeChromeTrace(path, TRACE_SECONDS)) std::printf("Wrote %s\n", path.c_str());
+                    else std::printf("Could not write %s\n", path.c_str());
+                }
+#endif
+            }
+            if (const auto* key = ev->getIf<sf::Event::KeyReleased>()) {
+                if (key->scancode == sf::Keyboard::Scan::LShift || key->scancode == sf::Keyboard::Scan::RShift) brushHeld = false;
             }
             // NEW: dig/place
             if (const auto* mb = ev->getIf<sf::Event::MouseButtonPressed>()) {
@@ -78,11 +116,10 @@ int main() {
                 const sf::Vector2f worldPos =
                     window.mapPixelToCoords({mb->position.x, mb->position.y}, cam.view());
                 
-                if (mb->button == sf::Mouse::Button::Left) {
-                    world.setTileAtPixel(worldPos, Tile::Air);   // dig
-                } else if (mb->button == sf::Mouse::Button::Right) {
-                    world.setTileAtPixel(worldPos, selectedTile); // place selected tile
-                }
+                const bool dig = mb->button == sf::Mouse::Button::Left;
+                const bool place = mb->button == sf::Mouse::Button::Right;
+                const TileID id = dig ? Tile::Air : selectedTile;
+                if (dig || place) sim.edit(worldPos, id, brushHeld); // applied by the next tick
             }
             cam.handleEvent(*ev);
         }
@@ -90,102 +127,60 @@ int main() {
 
         const float dt = frameClock.restart().asSeconds();
         cam.update(dt);
-        
-        // Update day/night cycle
-        gameTime += dt;
-        float dayProgress = std::fmod(gameTime / dayLength, 1.0f); // 0.0 to 1.0
-        
-        // Calculate ambient light based on time of day
-        // 0.0-0.15 = night, 0.15-0.35 = dawn, 0.35-0.65 = day, 0.65-0.85 = dusk, 0.85-1.0 = night
-        unsigned newAmbientLight;
-        if (dayProgress < 0.15f) {
-            // Night
-            newAmbientLight = 2; // Dark
-        } else if (dayProgress < 0.35f) {
-            // Dawn - longer gradual brightening
-            float t = (dayProgress - 0.15f) / 0.2f; // 0.2 duration for smooth transition
-            newAmbientLight = static_cast<unsigned>(2 + t * 10); // 2 to 12
-        } else if (dayProgress < 0.65f) {
-            // Full day - longer daylight period
-            newAmbientLight = 12; // Full daylight
-        } else if (dayProgress < 0.85f) {
-            // Dusk - longer gradual dimming  
-            float t = (dayProgress - 0.65f) / 0.2f; // 0.2 duration for smooth transition
-            newAmbientLight = static_cast<unsigned>(12 - t * 10); // 12 to 2
-        } else {
-            // Night
-            newAmbientLight = 2; // Dark
-        }
-        
-        // Update lighting if ambient light changed
-        if (newAmbientLight != currentAmbientLight) {
-            currentAmbientLight = newAmbientLight;
-            world.updateAmbientLight(currentAmbientLight);
-        }
-
-        // Lazy-load visible chunks around the camera
-        world.ensureVisible(cam.view(), /*inflatePixels=*/TILE_SIZE * 8.f, /*keepMarginChunks=*/2);
+        // Chunks are loaded and meshed around where the camera is now
+        sim.setCamera(cam.view(), ViewMotion{cam.velocity(), cam.zoomRate()});
 
+        // Draw the latest tick, with the time of day blended between it and the one
+        // before, one tick behind, so dawn and dusk move every frame
+        if (sim.acquire()) {
+            prevGameTime = tickGameTime;
+            tickGameTime = sim.snapshot().gameTime;
+            tickClock.restart();
+        }
+        const SimSnapshot& snapshot = sim.snapshot();
+        const double alpha = std::min(1.0, static_cast<double>(tickClock.getElapsedTime().asSeconds()) * Simulation::TICK_RATE);
+        const float dayProgress = DayNight::progress(prevGameTime + (tickGameTime - prevGameTime) * alpha);
+        light.setAmbient(DayNight::ambient(dayProgress));
 
         // FPS
         accum += dt; frames += 1;
         if (accum >= 0.25f && fontLoaded) {
             const float fps = frames / accum; frames = 0; accum = 0.f;
-            char buf[64]; std::snprintf(buf, sizeof(buf), "FPS: %.1f", fps);
+            char buf[256];
+            int len = std::snprintf(buf, sizeof(buf), "FPS: %.1f\nTick: %.2f ms\nPrefetch: %llu ready / %llu missed\nLOD: %u\nDeferred jobs: %zu",
+                                    fps, snapshot.tickMs,
+                                    static_cast<unsigned long long>(snapshot.prefetch.readyOnArrival),
+                                    static_cast<unsigned long long>(snapshot.prefetch.missedOnArrival), snapshot.lod,
+                                    snapshot.deferredJobs);
+            if (snapshot.unsavedChunks > 0 && len > 0 && static_cast<size_t>(len) < sizeof(buf)) {
+                std::snprintf(buf + len, sizeof(buf) - static_cast<size_t>(len),
+                              "\nUNSAVED chunks: %zu (save directory not writable)", snapshot.unsavedChunks);
+            }
             fpsText.setString(buf);
         }
 
-        // Calculate sky color based on time of day with smooth long gradients
-        sf::Color skyColor;
-        if (dayProgress < 0.15f) {
-            // Night - dark purple/blue
-            skyColor = sf::Color(15, 8, 35);
-        } else if (dayProgress < 0.35f) {
-            // Dawn - longer dark to purple/pink gradient
-            float t = (dayProgress - 0.15f) / 0.2f; // Smoother over longer period
-            skyColor = sf::Color(
-                static_cast<std::uint8_t>(15 + t * 105),   // 15 to 120 (purple)
-                static_cast<std::uint8_t>(8 + t * 62),     // 8 to 70   (purple tones)
-                static_cast<std::uint8_t>(35 + t * 145)    // 35 to 180 (brighter)
-            );
-        } else if (dayProgress < 0.5f) {
-            // Early day - transition from dawn purple to blue
-            float t = (dayProgress - 0.35f) / 0.15f; // Longer transition
-            skyColor = sf::Color(
-                static_cast<std::uint8_t>(120 - t * 35),   // 120 to 85  
-                static_cast<std::uint8_t>(70 + t * 100),   // 70 to 170  
-                static_cast<std::uint8_t>(180 + t * 55)    // 180 to 235 
-            );
-        } else if (dayProgress < 0.65f) {
-            // Full day - cute blue
-            skyColor = sf::Color(85, 170, 235);
-        } else if (dayProgress < 0.85f) {
-            // Dusk - longer blue to warm orange gradient
-            float t = (dayProgress - 0.65f) / 0.2f; // Longer smooth transition
-            skyColor = sf::Color(
-                static_cast<std::uint8_t>(85 + t * 145),    // 85 to 230  (warm orange)
-                static_cast<std::uint8_t>(170 - t * 70),    // 170 to 100 (orange tone)
-                static_cast<std::uint8_t>(235 - t * 195)    // 235 to 40  (less blue)
-            );
-        } else {
-            // Night transition - longer orange to dark
-            float t = (dayProgress - 0.85f) / 0.15f; // Smoother transition to night
-            skyColor = sf::Color(
-                static_cast<std::uint8_t>(230 - t * 215),   // 230 to 15  (orange to dark)
-                static_cast<std::uint8_t>(100 - t * 92),    // 100 to 8   (dim to dark)
-                static_cast<std::uint8_t>(40 - t * 5)       // 40 to 35   (keep some purple)
-            );
-        }
-        
-        window.clear(skyColor);
+        window.clear(DayNight::skyColor(dayProgress));
         cam.applyTo(window);
-        window.draw(world);
+        {
+            WET_PROFILE_SCOPE("world.draw");
+            snapshot.world.draw(window, sf::RenderStates::Default, light.shader());
+        }
 
         window.setView(window.getDefaultView());
         if (fontLoaded) {
             window.draw(fpsText);
         }
-        window.display();
+#if WET_PROFILE
+        window.draw(profilerOverlay);
+#endif
+        {
+            WET_PROFILE_SCOPE("frame.present"); // includes the frame-rate limiter's wait
+            window.display();
+        }
+        WET_PROFILE_FRAME();
+#if WET_PROFILE
+        profilerOverlay.update();
+#endif
     }
     return 0;
 }